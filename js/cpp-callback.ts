@@ -77,6 +77,33 @@ function argToNotRead(arg: Argument): string {
   }
 }
 
+// A string pointer from a streaming buffer is only valid until the next read,
+// so when more arguments follow one, pin the buffer and read them all again
+// from the pinned position if the window moved while reading them
+function emitReadArguments(cpp: string[], args: Argument[], prefix: string, indent: string): void {
+  let reads = args.map(argToNotRead).join(' || ');
+  let needsPin = false;
+
+  for (let i = 0; i + 1 < args.length; i++) {
+    if (args[i].type === 'const char *') needsPin = true;
+  }
+
+  if (!needsPin) {
+    cpp.push(indent + 'if (' + reads + ') return false;');
+    return;
+  }
+
+  let start = prefix + 'start';
+  let failed = prefix + 'failed';
+  cpp.push(indent + 'size_t ' + start + ' = bb.pin();');
+  cpp.push(indent + 'bool ' + failed + ' = ' + reads + ';');
+  cpp.push(indent + 'if (bb.unpin() && !' + failed + ') {');
+  cpp.push(indent + '  bb.seek(' + start + ');');
+  cpp.push(indent + '  ' + failed + ' = ' + reads + ';');
+  cpp.push(indent + '}');
+  cpp.push(indent + 'if (' + failed + ') return false;');
+}
+
 function argToWrite(arg: Argument): string {
   switch (arg.type) {
     case 'bool ':
@@ -111,7 +138,7 @@ function emitReadField(cpp: string[], definitions: { [name: string]: Definition
     for (let i = 0; i < args.length; i++) {
       cpp.push(indent + argToDeclaration(args[i]) + ';');
     }
-    cpp.push(indent + 'if (' + args.map(argToNotRead).join(' || ') + ') return false;');
+    emitReadArguments(cpp, args, '_' + name + '_', indent);
     if (!field.isDeprecated) {
       cpp.push(indent + 'visitor.visit' + definition.name + '_' + name + '(' + args.map(argToName).join(', ') + ');');
     }
@@ -239,7 +266,7 @@ export function compileSchemaCallbackCPP(schema: Schema): string {
         for (let j = 0; j < args.length; j++) {
           cpp.push('  ' + argToDeclaration(args[j]) + ';');
         }
-        cpp.push('  if (' + args.map(argToNotRead).join(' || ') + ') return false;');
+        emitReadArguments(cpp, args, '_', '  ');
         cpp.push('  visitor.visit' + definition.name + '(' + args.map(argToName).join(', ') + ');');
         cpp.push('  return true;');
         cpp.push('}');
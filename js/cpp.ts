@@ -45,10 +45,126 @@ function cppFlagMask(i: number): number {
   return 1 << (i % 32) >>> 0;
 }
 
+function cppIsTrivial(definitions: { [name: string]: Definition }, field: Field): boolean {
+  switch (field.type) {
+    case 'bool':
+    case 'byte':
+    case 'int':
+    case 'uint':
+    case 'float':
+    case 'int64':
+    case 'uint64':
+      return true;
+  }
+  return field.type! in definitions && definitions[field.type!].kind === 'ENUM';
+}
+
 function cppIsFieldPointer(definitions: { [name: string]: Definition }, field: Field): boolean {
   return !field.isArray && field.type! in definitions && definitions[field.type!].kind !== 'ENUM';
 }
 
+// Arrays of varints are decoded all at once, which is much faster than one at a time
+function cppBulkDecode(definitions: { [name: string]: Definition }, field: Field, data: string): string | null {
+  switch (field.type) {
+    case 'int': return '_bb.readVarIntArray(' + data + ', _count)';
+    case 'uint': return '_bb.readVarUintArray(' + data + ', _count)';
+  }
+
+  let type = definitions[field.type!];
+  if (type && type.kind === 'ENUM') {
+    return '_bb.readVarUintArray(reinterpret_cast<uint32_t *>(' + data + '), _count)';
+  }
+
+  return null;
+}
+
+interface CursorWrite {
+  code: string;
+  maxSize: number;
+}
+
+// Fixed-size values can be written through a raw cursor into space reserved ahead of time
+function cppCursorWrite(definitions: { [name: string]: Definition }, field: Field, value: string): CursorWrite | null {
+  switch (field.type) {
+    case 'bool': return { code: 'kiwi::ByteBuffer::putByte(_out, ' + value + ');', maxSize: 1 };
+    case 'byte': return { code: 'kiwi::ByteBuffer::putByte(_out, ' + value + ');', maxSize: 1 };
+    case 'int': return { code: 'kiwi::ByteBuffer::putVarInt(_out, ' + value + ');', maxSize: 5 };
+    case 'uint': return { code: 'kiwi::ByteBuffer::putVarUint(_out, ' + value + ');', maxSize: 5 };
+    case 'float': return { code: 'kiwi::ByteBuffer::putVarFloat(_out, ' + value + ');', maxSize: 4 };
+    case 'string': return null;
+    case 'int64': return { code: 'kiwi::ByteBuffer::putVarInt64(_out, ' + value + ');', maxSize: 9 };
+    case 'uint64': return { code: 'kiwi::ByteBuffer::putVarUint64(_out, ' + value + ');', maxSize: 9 };
+  }
+
+  let type = definitions[field.type!];
+  if (type && type.kind === 'ENUM') {
+    return { code: 'kiwi::ByteBuffer::putVarUint(_out, static_cast<uint32_t>(' + value + '));', maxSize: 5 };
+  }
+
+  return null;
+}
+
+function cppVarUintSize(value: number): number {
+  let size = 1;
+  while (value >= 128) {
+    value = Math.floor(value / 128);
+    size++;
+  }
+  return size;
+}
+
+function cppEncodedSize(definitions: { [name: string]: Definition }, field: Field, value: string): string {
+  switch (field.type) {
+    case 'bool': return '1';
+    case 'byte': return '1';
+    case 'int': return 'kiwi::ByteBuffer::varIntSize(' + value + ')';
+    case 'uint': return 'kiwi::ByteBuffer::varUintSize(' + value + ')';
+    case 'float': return 'kiwi::ByteBuffer::varFloatSize(' + value + ')';
+    case 'string': return '(' + value + '.size() + 1)';
+    case 'int64': return 'kiwi::ByteBuffer::varInt64Size(' + value + ')';
+    case 'uint64': return 'kiwi::ByteBuffer::varUint64Size(' + value + ')';
+  }
+
+  let type = definitions[field.type!];
+  if (type.kind === 'ENUM') {
+    return 'kiwi::ByteBuffer::varUintSize(static_cast<uint32_t>(' + value + '))';
+  }
+
+  return value + (cppIsFieldPointer(definitions, field) ? '->' : '.') + 'encodedSize()';
+}
+
+// This must match kiwi::BinarySchema::definitionHash() in kiwi.h
+function cppDefinitionHash(definition: Definition): number {
+  let kinds = ['ENUM', 'STRUCT', 'MESSAGE'];
+  let hash = 2166136261;
+
+  let hashByte = (byte: number): void => {
+    hash = Math.imul(hash ^ byte, 16777619) >>> 0;
+  };
+
+  let hashString = (text: string): void => {
+    for (let i = 0; i < text.length; i++) hashByte(text.charCodeAt(i));
+    hashByte(0);
+  };
+
+  let hashUint32 = (value: number): void => {
+    for (let i = 0; i < 4; i++) hashByte((value >>> (i * 8)) & 255);
+  };
+
+  hashString(definition.name);
+  hashUint32(kinds.indexOf(definition.kind));
+  hashUint32(definition.fields.length);
+
+  for (let field of definition.fields) {
+    hashString(field.name);
+    hashString(definition.kind === 'ENUM' ? '' : field.type!);
+    hashUint32(field.isArray ? 1 : 0);
+    hashUint32(field.value);
+  }
+
+  return hash;
+}
+
 export function compileSchemaCPP(schema: Schema): string {
   let definitions: { [name: string]: Definition } = {};
   let cpp: string[] = [];
@@ -73,6 +189,11 @@ export function compileSchemaCPP(schema: Schema): string {
   cpp.push('public:');
   cpp.push('  bool parse(kiwi::ByteBuffer &bb);');
   cpp.push('  const kiwi::BinarySchema &underlyingSchema() const { return _schema; }');
+  cpp.push('');
+  cpp.push('  // Whether all or one of the definitions compiled in here are exactly the same in the parsed schema');
+  cpp.push('  bool isIdentical() const { return _isIdentical; }');
+  cpp.push('  bool isIdentical(const char *definition) const;');
+  cpp.push('');
 
   for (let i = 0; i < schema.definitions.length; i++) {
     let definition = schema.definitions[i];
@@ -84,6 +205,8 @@ export function compileSchemaCPP(schema: Schema): string {
   cpp.push('');
   cpp.push('private:');
   cpp.push('  kiwi::BinarySchema _schema;');
+  cpp.push('  bool _isIdentical = false;');
+  cpp.push('  bool _identical[' + Math.max(schema.definitions.length, 1) + '] = {};');
 
   for (let i = 0; i < schema.definitions.length; i++) {
     let definition = schema.definitions[i];
@@ -124,6 +247,18 @@ export function compileSchemaCPP(schema: Schema): string {
       cpp.push('#ifdef IMPLEMENT_SCHEMA_H');
       cpp.push('');
 
+      // The table can't be empty, so an empty schema gets a placeholder that's never read
+      cpp.push('static const struct { const char *name; uint32_t hash; } _definitionHashes[] = {');
+      for (let i = 0; i < schema.definitions.length; i++) {
+        let definition = schema.definitions[i];
+        cpp.push('  {"' + definition.name + '", ' + cppDefinitionHash(definition) + 'u},');
+      }
+      if (schema.definitions.length === 0) {
+        cpp.push('  {"", 0},');
+      }
+      cpp.push('};');
+      cpp.push('');
+
       cpp.push('bool BinarySchema::parse(kiwi::ByteBuffer &bb) {');
       cpp.push('  if (!_schema.parse(bb)) return false;');
 
@@ -134,10 +269,25 @@ export function compileSchemaCPP(schema: Schema): string {
         }
       }
 
+      cpp.push('  _isIdentical = true;');
+      cpp.push('  for (uint32_t i = 0; i < ' + schema.definitions.length + '; i++) {');
+      cpp.push('    uint32_t index, hash;');
+      cpp.push('    _identical[i] = _schema.findDefinition(_definitionHashes[i].name, index) &&');
+      cpp.push('      _schema.definitionHash(index, hash) && hash == _definitionHashes[i].hash;');
+      cpp.push('    _isIdentical = _isIdentical && _identical[i];');
+      cpp.push('  }');
       cpp.push('  return true;');
       cpp.push('}');
       cpp.push('');
 
+      cpp.push('bool BinarySchema::isIdentical(const char *definition) const {');
+      cpp.push('  for (uint32_t i = 0; i < ' + schema.definitions.length + '; i++) {');
+      cpp.push('    if (!strcmp(_definitionHashes[i].name, definition)) return _identical[i];');
+      cpp.push('  }');
+      cpp.push('  return false;');
+      cpp.push('}');
+      cpp.push('');
+
       for (let i = 0; i < schema.definitions.length; i++) {
         let definition = schema.definitions[i];
         if (definition.kind === 'MESSAGE') {
@@ -205,7 +355,9 @@ export function compileSchemaCPP(schema: Schema): string {
         }
 
         cpp.push('  bool encode(kiwi::ByteBuffer &bb);');
-        cpp.push('  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);');
+        cpp.push('  size_t encodedSize() const;');
+        cpp.push('  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);');
+        cpp.push('  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }');
         cpp.push('');
         cpp.push('private:');
         cpp.push('  uint32_t _flags[' + (fields.length + 31 >> 5) + '] = {};');
@@ -306,6 +458,40 @@ export function compileSchemaCPP(schema: Schema): string {
 
         cpp.push('bool ' + definition.name + '::encode(kiwi::ByteBuffer &_bb) {');
 
+        // Structs of only fixed-size fields are written all at once after checking every field
+        let structWrites: CursorWrite[] | null = definition.kind === 'STRUCT' ? [] : null;
+        for (let j = 0; j < fields.length && structWrites !== null; j++) {
+          let write = fields[j].isArray ? null : cppCursorWrite(definitions, fields[j], cppFieldName(fields[j]));
+          if (write !== null) structWrites.push(write);
+          else structWrites = null;
+        }
+
+        if (structWrites !== null) {
+          for (let j = 0; j < fields.length; j++) {
+            cpp.push('  if (' + fields[j].name + '() == nullptr) return false;');
+          }
+          // Near the end of an exact reservation, fall back to checked writes below
+          let maxSize = structWrites.reduce((size, write) => size + write.maxSize, 0);
+          cpp.push('  if (_bb.writeBatchSize(1, ' + maxSize + ')) {');
+          cpp.push('    uint8_t *_out = _bb.beginWrite(' + maxSize + ');');
+          for (let write of structWrites) {
+            cpp.push('    ' + write.code);
+          }
+          cpp.push('    _bb.endWrite(_out);');
+          cpp.push('    return true;');
+          cpp.push('  }');
+        }
+
+        else {
+          for (let j = 0; j < fields.length; j++) {
+            let field = fields[j];
+            if (!field.isDeprecated && field.isArray && field.type !== 'byte' && cppCursorWrite(definitions, field, '_it') !== null) {
+              cpp.push('  uint8_t *_out;');
+              break;
+            }
+          }
+        }
+
         for (let j = 0; j < fields.length; j++) {
           let field = fields[j];
 
@@ -346,7 +532,7 @@ export function compileSchemaCPP(schema: Schema): string {
             }
 
             case 'string': {
-              code = '_bb.writeString(' + value + '.c_str());';
+              code = '_bb.writeString(' + value + ');';
               break;
             }
 
@@ -377,9 +563,10 @@ export function compileSchemaCPP(schema: Schema): string {
             }
           }
 
+          let cursorWrite = field.isArray ? cppCursorWrite(definitions, field, value) : null;
           let indent = '  ';
           if (definition.kind === 'STRUCT') {
-            cpp.push('  if (' + field.name + '() == nullptr) return false;');
+            if (structWrites === null) cpp.push('  if (' + field.name + '() == nullptr) return false;');
           } else {
             cpp.push('  if (' + field.name + '() != nullptr) {');
             indent = '    ';
@@ -389,7 +576,20 @@ export function compileSchemaCPP(schema: Schema): string {
             cpp.push(indent + '_bb.writeVarUint(' + field.value + ');');
           }
 
-          if (field.isArray) {
+          if (field.isArray && field.type === 'byte') {
+            cpp.push(indent + '_bb.writeVarUint(' + name + '.size());');
+            cpp.push(indent + '_bb.writeBytes(' + name + '.data(), ' + name + '.size());');
+          } else if (field.isArray && cursorWrite !== null) {
+            cpp.push(indent + '_bb.writeVarUint(' + name + '.size());');
+            let type = cppType(definitions, field, false);
+            cpp.push(indent + 'for (const ' + type + ' *_p = ' + name + '.begin(), *_end = ' + name + '.end(); _p != _end;) {');
+            cpp.push(indent + '  size_t _count = _bb.writeBatchSize(_end - _p, ' + cursorWrite.maxSize + ');');
+            cpp.push(indent + '  if (_count == 0) { const ' + type + ' &_it = *_p++; ' + code + ' continue; }');
+            cpp.push(indent + '  _out = _bb.beginWrite(' + cursorWrite.maxSize + ' * _count);');
+            cpp.push(indent + '  for (const ' + type + ' *_batch = _p + _count; _p != _batch; _p++) { const ' + type + ' &_it = *_p; ' + cursorWrite.code + ' }');
+            cpp.push(indent + '  _bb.endWrite(_out);');
+            cpp.push(indent + '}');
+          } else if (field.isArray) {
             cpp.push(indent + '_bb.writeVarUint(' + name + '.size());');
             cpp.push(indent + 'for (' + cppType(definitions, field, false) + ' &_it : ' + name + ') ' + code);
           } else {
@@ -409,7 +609,40 @@ export function compileSchemaCPP(schema: Schema): string {
         cpp.push('}');
         cpp.push('');
 
-        cpp.push('bool ' + definition.name + '::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {');
+        cpp.push('size_t ' + definition.name + '::encodedSize() const {');
+        cpp.push('  size_t _size = ' + (definition.kind === 'MESSAGE' ? 1 : 0) + ';');
+
+        for (let j = 0; j < fields.length; j++) {
+          let field = fields[j];
+
+          if (field.isDeprecated) {
+            continue;
+          }
+
+          let name = cppFieldName(field);
+          let value = field.isArray ? '_it' : name;
+          let tagSize = definition.kind === 'MESSAGE' ? cppVarUintSize(field.value) + ' + ' : '';
+          let code = cppEncodedSize(definitions, field, value);
+
+          cpp.push('  if (' + field.name + '() != nullptr) {');
+
+          if (field.isArray && (field.type === 'bool' || field.type === 'byte')) {
+            cpp.push('    _size += ' + tagSize + 'kiwi::ByteBuffer::varUintSize(' + name + '.size()) + ' + name + '.size();');
+          } else if (field.isArray) {
+            cpp.push('    _size += ' + tagSize + 'kiwi::ByteBuffer::varUintSize(' + name + '.size());');
+            cpp.push('    for (const ' + cppType(definitions, field, false) + ' &_it : ' + name + ') _size += ' + code + ';');
+          } else {
+            cpp.push('    _size += ' + tagSize + code + ';');
+          }
+
+          cpp.push('  }');
+        }
+
+        cpp.push('  return _size;');
+        cpp.push('}');
+        cpp.push('');
+
+        cpp.push('bool ' + definition.name + '::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {');
 
         for (let j = 0; j < fields.length; j++) {
           if (fields[j].isArray) {
@@ -418,6 +651,13 @@ export function compileSchemaCPP(schema: Schema): string {
           }
         }
 
+        for (let j = 0; j < fields.length; j++) {
+          if (fields[j].isArray && fields[j].type === 'byte' && !fields[j].isDeprecated) {
+            cpp.push('  const uint8_t *_bytes;');
+            break;
+          }
+        }
+
         if (definition.kind === 'MESSAGE') {
           cpp.push('  while (true) {');
           cpp.push('    uint32_t _type;');
@@ -461,7 +701,7 @@ export function compileSchemaCPP(schema: Schema): string {
             }
 
             case 'string': {
-              code = '_bb.readString(' + value + ', _pool)';
+              code = '(_borrow ? _bb.readBorrowedString(' + value + ') : _bb.readString(' + value + ', _pool))';
               break;
             }
 
@@ -487,7 +727,7 @@ export function compileSchemaCPP(schema: Schema): string {
               }
 
               else {
-                code = value + (isPointer ? '->' : '.') + 'decode(_bb, _pool, _schema)';
+                code = value + (isPointer ? '->' : '.') + 'decode(_bb, _pool, _schema, _borrow)';
               }
             }
           }
@@ -500,12 +740,36 @@ export function compileSchemaCPP(schema: Schema): string {
             indent = '        ';
           }
 
-          if (field.isArray) {
-            cpp.push(indent + 'if (!_bb.readVarUint(_count)) return false;');
+          // Byte arrays are either copied all at once or borrowed from the input
+          if (field.isArray && field.type === 'byte') {
             if (field.isDeprecated) {
-              cpp.push(indent + 'for (' + type + ' &_it : _pool.array<' + cppType(definitions, field, false) + '>(_count)) if (!' + code + ') return false;');
+              cpp.push(indent + 'if (!_bb.readVarUint(_count) || !_bb.skipBytes(_count)) return false;');
+            } else {
+              cpp.push(indent + 'if (!_bb.readVarUint(_count) || !(_borrow ? _bb.readBorrowedBytes(_bytes, _count) : _bb.readBytes(_bytes, _count))) return false;');
+              cpp.push(indent + '_flags[' + cppFlagIndex(j) + '] |= ' + cppFlagMask(j) + '; ' + name +
+                ' = _borrow ? kiwi::Array<uint8_t>(const_cast<uint8_t *>(_bytes), _count) : _pool.array(_bytes, _count);');
+            }
+          }
+
+          // Arrays are decoded into a local first so a failed decode never
+          // leaves a partially-filled array (e.g. of reused pool memory) visible
+          else if (field.isArray) {
+            let array = '_' + field.name + '_array';
+            cpp.push(indent + 'if (!_bb.readVarUint(_count)) return false;');
+
+            // Arrays of plain values are completely overwritten, so skip zeroing them first
+            let allocate = cppIsTrivial(definitions, field) ? 'arrayUninitialized' : 'array';
+            cpp.push(indent + 'kiwi::Array<' + type + '> ' + array + ' = _pool.' + allocate + '<' + type + '>(_count);');
+
+            let bulkCode = cppBulkDecode(definitions, field, array + '.data()');
+            if (bulkCode !== null) {
+              cpp.push(indent + 'if (!' + bulkCode + ') return false;');
             } else {
-              cpp.push(indent + 'for (' + type + ' &_it : set_' + field.name + '(_pool, _count)) if (!' + code + ') return false;');
+              cpp.push(indent + 'for (' + type + ' &_it : ' + array + ') if (!' + code + ') return false;');
+            }
+
+            if (!field.isDeprecated) {
+              cpp.push(indent + '_flags[' + cppFlagIndex(j) + '] |= ' + cppFlagMask(j) + '; ' + name + ' = ' + array + ';');
             }
           }
 
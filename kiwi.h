@@ -4,17 +4,95 @@
 #include <assert.h>
 #include <initializer_list>
 #include <memory.h>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <errno.h>
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+  #define KIWI_HAS_FILE_DESCRIPTORS
+#endif
 
 namespace kiwi {
   class String;
   class MemoryPool;
 
+  // Where ByteBuffer and MemoryPool get their memory from, e.g. to use an
+  // arena, a NUMA-aware heap, or to track usage. Memory from allocate() must be
+  // suitably aligned for any type like malloc(). The default allocator from
+  // standard() uses new[] and delete[]. An allocator must outlive everything
+  // that uses it.
+  class Allocator {
+  public:
+    virtual ~Allocator() {}
+    virtual void *allocate(size_t size) = 0;
+    virtual void free(void *data, size_t size) = 0;
+
+    static Allocator *standard();
+
+    // Keeps up to "capacity" bytes of freed memory per thread for reuse by
+    // later allocations of the same size, so short-lived pools and buffers can
+    // reuse warm memory without any synchronization. Memory freed on another
+    // thread goes to that thread's cache. Only the most recently used sizes
+    // are kept, and blocks over 1mb aren't cached at all. The capacity
+    // defaults to 4mb and is set for the calling thread only, and 0 disables
+    // the cache.
+    static Allocator *threadCache();
+    static void setThreadCacheCapacity(size_t capacity);
+
+  private:
+    class ThreadCache;
+  };
+
+#ifdef KIWI_STATISTICS
+  // Statistics are only tracked when KIWI_STATISTICS is defined, and only on
+  // the slow paths that allocate memory
+  struct ByteBufferStatistics {
+    size_t size = 0;
+    size_t capacity = 0; // Including all segments
+    size_t segments = 0;
+    size_t reallocations = 0;
+    size_t copiedBytes = 0; // By reallocations and by discarding streamed input
+    size_t refills = 0;
+  };
+
+  struct MemoryPoolStatistics {
+    size_t chunks = 0; // Not including the inline chunk of an InlineMemoryPool
+    size_t reservedBytes = 0;
+    size_t usedBytes = 0;
+    size_t wastedBytes = 0; // Left at the end of chunks the pool has moved past
+    size_t peakUsedBytes = 0;
+    size_t peakReservedBytes = 0;
+    size_t chunkAllocations = 0;
+  };
+
+  // Process-wide hooks that get the final statistics of every buffer and pool
+  // when it's destroyed, e.g. to aggregate them into a metrics system. They
+  // may be called from any thread.
+  struct StatisticsHooks {
+    void (*byteBuffer)(const ByteBufferStatistics &statistics) = nullptr;
+    void (*memoryPool)(const MemoryPoolStatistics &statistics) = nullptr;
+  };
+
+  StatisticsHooks &statisticsHooks();
+#endif
+
+  ////////////////////////////////////////////////////////////////////////////////
+
   class ByteBuffer {
   public:
-    ByteBuffer();
+    ByteBuffer() : ByteBuffer(Allocator::standard()) {}
+    explicit ByteBuffer(Allocator *allocator);
     ByteBuffer(uint8_t *data, size_t size);
     ByteBuffer(const uint8_t *data, size_t size);
     ~ByteBuffer();
@@ -22,8 +100,48 @@ namespace kiwi {
     ByteBuffer &operator = (const ByteBuffer &) = delete;
 
     uint8_t *data() const { return _data; }
-    size_t size() const { return _size; }
-    size_t index() const { return _index; }
+    size_t size() const { return _offset + _size; }
+    size_t index() const { return _offset + _index; }
+
+    // Streaming input: the buffer reads from "source" in blocks of up to
+    // "blockSize" bytes as they are consumed and discards the bytes that were
+    // already read, so the whole input never needs to be in memory at once.
+    // The "source" function returns 0 at the end of the input. Pointers into
+    // the data (e.g. from readString(const char *&)) are only valid until the
+    // next read, so borrowed decoding can't be used with streaming input.
+    typedef size_t (*Source)(void *context, uint8_t *data, size_t size);
+    void setSource(Source source, void *context, size_t blockSize = DEFAULT_BLOCK_SIZE);
+    void setSource(FILE *file, size_t blockSize = DEFAULT_BLOCK_SIZE);
+  #ifdef KIWI_HAS_FILE_DESCRIPTORS
+    void setSource(int fd, size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+    // Maps a file read-only so it can be decoded without copying it into
+    // memory. The buffer then acts like one constructed from "const uint8_t *"
+    // and unmaps the file when destroyed. Use "populate" to fault in all pages
+    // up front where that's supported. Only regular files can be mapped, so
+    // use setSource() for pipes and devices.
+    bool mapFile(const char *path, bool populate = false);
+  #endif
+
+    // To use several pointers from streaming input at once, pin() the position
+    // before reading them. Everything from there on then stays in the window,
+    // which grows instead of discarding it. If unpin() returns true the window
+    // moved in the meantime, so seek() back to the pinned position and read
+    // the values again to get valid pointers. In-memory input never moves.
+    size_t pin();
+    bool unpin();
+    void seek(size_t index);
+
+    // Segmented output: instead of reallocating and copying everything written
+    // so far when it runs out of space, the buffer starts a new segment of at
+    // least "segmentSize" bytes. Only the last segment is available through
+    // data(), so use segmentCount() and segments() to get all of them (e.g. as
+    // an array of "struct iovec" for writev). This must be called before
+    // anything is written, and segmented buffers can't be read from.
+    void setSegmentSize(size_t segmentSize);
+    size_t segmentCount() const;
+    template <typename IOVec>
+    size_t segments(IOVec *result, size_t count) const;
 
     bool readByte(bool &result);
     bool readByte(uint8_t &result);
@@ -32,45 +150,153 @@ namespace kiwi {
     bool readVarInt(int32_t &result);
     bool readString(const char *&result);
     bool readString(String &result, MemoryPool &pool);
+    bool readBorrowedString(String &result);
+    bool readBytes(const uint8_t *&result, uint32_t count);
+    bool readBorrowedBytes(const uint8_t *&result, uint32_t count);
+    bool skipBytes(uint64_t count);
     bool readVarUint64(uint64_t &result);
     bool readVarInt64(int64_t &result);
+    bool readVarUintArray(uint32_t *result, uint32_t count);
+    bool readVarIntArray(int32_t *result, uint32_t count);
+    bool skipVarUints(uint64_t count);
 
     void writeByte(uint8_t value);
     void writeVarFloat(float value);
     void writeVarUint(uint32_t value);
     void writeVarInt(int32_t value);
     void writeString(const char *value);
+    void writeString(const String &value);
+    void writeBytes(const uint8_t *data, size_t count);
     void writeVarUint64(uint64_t value);
     void writeVarInt64(int64_t value);
 
+    // Reserves capacity for writing "amount" more bytes without reallocating
+    void reserve(size_t amount);
+
+    // Unchecked writing: beginWrite() makes room for at most "amount" bytes and
+    // returns a cursor, the "put" functions below write through the cursor and
+    // advance it without any capacity checks, and endWrite() commits the bytes
+    // up to the final cursor position. At most 1 byte is needed for putByte(),
+    // 4 for putVarFloat(), 5 for putVarUint() and 9 for putVarUint64().
+    uint8_t *beginWrite(size_t amount);
+    void endWrite(uint8_t *end);
+
+    // Arrays are written in unchecked batches. This returns how many of the
+    // "count" remaining elements of at most "maxSize" bytes each to write in
+    // the next batch, or 0 if the next element should use a checked write
+    // because it may or may not fit in the remaining capacity.
+    size_t writeBatchSize(size_t count, size_t maxSize) const;
+
+    static void putByte(uint8_t *&out, uint8_t value) { *out++ = value; }
+    static void putVarFloat(uint8_t *&out, float value);
+    static void putVarUint(uint8_t *&out, uint32_t value);
+    static void putVarInt(uint8_t *&out, int32_t value) { putVarUint(out, (value << 1) ^ (value >> 31)); }
+    static void putVarUint64(uint8_t *&out, uint64_t value);
+    static void putVarInt64(uint8_t *&out, int64_t value) { putVarUint64(out, (value << 1) ^ (value >> 63)); }
+
+    // The number of bytes each of the "write" functions above will write
+    static size_t varFloatSize(float value);
+    static size_t varUintSize(uint32_t value) { return value < 1u << 7 ? 1 : value < 1u << 14 ? 2 : value < 1u << 21 ? 3 : value < 1u << 28 ? 4 : 5; }
+    static size_t varIntSize(int32_t value) { return varUintSize((value << 1) ^ (value >> 31)); }
+    static size_t varUint64Size(uint64_t value);
+    static size_t varInt64Size(int64_t value) { return varUint64Size((value << 1) ^ (value >> 63)); }
+
+  #ifdef KIWI_STATISTICS
+    ByteBufferStatistics statistics() const;
+  #endif
+
   private:
-    void _growBy(size_t amount);
+    struct Segment {
+      uint8_t *data = nullptr;
+      size_t size = 0;
+      size_t capacity = 0;
+      Segment *next = nullptr;
+    };
+
+    bool _refill(size_t amount);
+    void _makeRoom(size_t amount, size_t capacity);
+    void _reallocate(size_t capacity);
+    void _startSegment(size_t capacity);
+    uint64_t _peekUint64() const;
 
-    enum { INITIAL_CAPACITY = 256 };
+    static uint64_t _compactVarBytes(uint64_t bytes);
+    static uint32_t _varByteCount(uint64_t stopBits);
+
+    enum { INITIAL_CAPACITY = 256, DEFAULT_BLOCK_SIZE = 1 << 16, WRITE_BATCH = 256 };
     uint8_t *_data = nullptr;
     size_t _size = 0;
     size_t _capacity = 0;
     size_t _index = 0;
+    size_t _segmentSize = 0;
+    size_t _offset = 0; // The number of bytes before "_data", either discarded or in segments
+    size_t _blockSize = 0;
+    size_t _pinned = 0;
+    bool _isPinned = false;
+    bool _pinMoved = false;
+    Source _source = nullptr;
+    void *_sourceContext = nullptr;
+    Segment *_firstSegment = nullptr;
+    Segment *_lastSegment = nullptr;
     bool _ownsData = false;
     bool _isConst = false;
+    bool _isMapped = false;
+    Allocator *_allocator = Allocator::standard();
+
+  #ifdef KIWI_STATISTICS
+    size_t _reallocations = 0;
+    size_t _copiedBytes = 0;
+    size_t _refills = 0;
+  #endif
   };
 
+  // Defined here instead of in the implementation so any translation unit can
+  // instantiate it with its own iovec type
+  template <typename IOVec>
+  size_t ByteBuffer::segments(IOVec *result, size_t count) const {
+    size_t i = 0;
+
+    for (Segment *segment = _firstSegment; segment && i < count; segment = segment->next, i++) {
+      result[i].iov_base = segment->data;
+      result[i].iov_len = segment->size;
+    }
+
+    if (_size > 0 && i < count) {
+      result[i].iov_base = _data;
+      result[i].iov_len = _size;
+      i++;
+    }
+
+    return i;
+  }
+
   ////////////////////////////////////////////////////////////////////////////////
 
   class String {
   public:
     String() {}
-    explicit String(const char *c_str) : _c_str(c_str) {}
+    explicit String(const char *c_str) : _c_str(c_str), _size(strlen(c_str)) {}
+    String(const char *c_str, uint32_t size) : _c_str(c_str), _size(size) { assert(c_str[size] == '\0'); }
 
     const char *c_str() const { return _c_str; }
+    uint32_t size() const { return _size; } // Doesn't include the null terminator
 
   private:
     const char *_c_str = nullptr;
+    uint32_t _size = 0;
   };
 
-  inline bool operator == (const String &a, const String &b) { return !strcmp(a.c_str(), b.c_str()); }
+  inline bool operator == (const String &a, const String &b) {
+    return a.size() == b.size() && (a.c_str() == b.c_str() || !memcmp(a.c_str(), b.c_str(), a.size()));
+  }
   inline bool operator != (const String &a, const String &b) { return !(a == b); }
 
+  // Orders by bytes, with prefixes first
+  inline bool operator < (const String &a, const String &b) {
+    uint32_t size = a.size() < b.size() ? a.size() : b.size();
+    int order = size ? memcmp(a.c_str(), b.c_str(), size) : 0;
+    return order < 0 || (order == 0 && a.size() < b.size());
+  }
+
   ////////////////////////////////////////////////////////////////////////////////
 
   template <typename T>
@@ -102,43 +328,231 @@ namespace kiwi {
   class MemoryPool {
   public:
     MemoryPool() {}
-    ~MemoryPool() { clear(); }
+    explicit MemoryPool(Allocator *allocator) : _allocator(allocator) {}
+    ~MemoryPool();
+
+    // Chunks start at "initialCapacity" bytes and double in size up to
+    // "maxCapacity" bytes. Allocations that are at least half the size of the
+    // next chunk get a dedicated chunk of their own instead.
+    MemoryPool(uint32_t initialCapacity, uint32_t maxCapacity, Allocator *allocator = Allocator::standard());
+
     MemoryPool(const MemoryPool &) = delete;
     MemoryPool &operator = (const MemoryPool &) = delete;
 
     void clear();
 
+    // Frees everything that was allocated but keeps the chunks around for
+    // reuse, up to "maxRetained" bytes of them
+    void reset(size_t maxRetained = SIZE_MAX);
+
+    // A position in the pool that rollback() can return to in constant time,
+    // e.g. to discard a failed or speculative decode. Chunks after the mark
+    // are kept for reuse and dedicated chunks allocated since then are freed.
+    // A mark can't be used after clear(), reset(), or a rollback() to an
+    // earlier mark.
+    struct Mark {
+      void *chunk;
+      size_t used;
+      void *large;
+    };
+    Mark mark() const { return {_current, _current ? _current->used : 0, _large}; }
+    void rollback(const Mark &mark);
+
+    // Memory is zero-initialized by default. The "Uninitialized" variants skip
+    // that for trivial types when the caller is going to overwrite all of it.
     template <typename T>
     T *allocate(uint32_t count = 1);
 
+    template <typename T>
+    T *allocateUninitialized(uint32_t count = 1);
+
     template <typename T>
     Array<T> array(uint32_t size) { return Array<T>(allocate<T>(size), size); }
 
+    template <typename T>
+    Array<T> arrayUninitialized(uint32_t size) { return Array<T>(allocateUninitialized<T>(size), size); }
+
+    template <typename T>
+    Array<T> array(const T *data, uint32_t size);
+
     String string(const char *data, uint32_t count);
     String string(const char *c_str) { return string(c_str, strlen(c_str)); }
 
-  private:
-    enum { INITIAL_CAPACITY = 1 << 12 };
+  #ifdef KIWI_STATISTICS
+    MemoryPoolStatistics statistics() const;
+  #endif
 
+  protected:
     struct Chunk {
       uint8_t *data = nullptr;
-      uint32_t capacity = 0;
-      uint32_t used = 0;
+      size_t capacity = 0;
+      size_t used = 0;
       Chunk *next = nullptr;
     };
 
+    // Makes "data" the first chunk of the pool without ever freeing it. This
+    // clears the pool, and passing nullptr detaches the current inline chunk.
+    void _setInlineChunk(uint8_t *data, size_t size);
+
+  private:
+    enum { INITIAL_CAPACITY = 1 << 12, MAX_CAPACITY = 1 << 20 };
+
+    uint8_t *_allocate(size_t size, size_t alignment);
+    uint8_t *_allocateChunk(size_t size);
+    Chunk *_newChunk(size_t capacity);
+    void _deleteChunks(Chunk *chunk);
+
+  #ifdef KIWI_STATISTICS
+    void _updatePeak() const;
+    void _retireCurrent();
+    void _recountUsage();
+  #endif
+
     Chunk *_first = nullptr;
     Chunk *_last = nullptr;
+    Chunk *_current = nullptr;
+    Chunk *_large = nullptr;
+    Chunk *_inline = nullptr;
+    size_t _initialCapacity = INITIAL_CAPACITY;
+    size_t _maxCapacity = MAX_CAPACITY;
+    size_t _nextCapacity = INITIAL_CAPACITY;
+    Allocator *_allocator = Allocator::standard();
+
+  #ifdef KIWI_STATISTICS
+    size_t _chunkCount = 0;
+    size_t _reserved = 0;
+    size_t _retiredUsed = 0; // Everything used outside of "_current"
+    size_t _retiredWasted = 0;
+    size_t _chunkAllocations = 0;
+    mutable size_t _peakUsed = 0;
+    mutable size_t _peakReserved = 0;
+  #endif
+  };
+
+  // A pool whose first "inlineCapacity" bytes live inside the pool object, so
+  // small decodes using a pool on the stack never touch the heap. Allocations
+  // that don't fit fall back to regular chunks.
+  template <size_t inlineCapacity>
+  class InlineMemoryPool : public MemoryPool {
+  public:
+    InlineMemoryPool() { _setInlineChunk(_buffer, sizeof(_buffer)); }
+    explicit InlineMemoryPool(Allocator *allocator) : MemoryPool(allocator) { _setInlineChunk(_buffer, sizeof(_buffer)); }
+    InlineMemoryPool(uint32_t initialCapacity, uint32_t maxCapacity, Allocator *allocator = Allocator::standard())
+      : MemoryPool(initialCapacity, maxCapacity, allocator) { _setInlineChunk(_buffer, sizeof(_buffer)); }
+
+  private:
+    alignas(max_align_t) uint8_t _buffer[sizeof(Chunk) + inlineCapacity];
+  };
+
+  ////////////////////////////////////////////////////////////////////////////////
+
+  // A dynamically-typed value decoded by BinarySchema::decode(). Everything is
+  // allocated in the pool passed to decode(), except for type, field and enum
+  // names, which point into the schema and are only valid while it's alive.
+  // Objects store their fields in an array sorted by name.
+  class Value {
+  public:
+    enum Kind : uint8_t {
+      BOOL,
+      BYTE,
+      INT,
+      UINT,
+      FLOAT,
+      STRING,
+      INT64,
+      UINT64,
+      ARRAY,
+      ENUM,
+      OBJECT,
+    };
+
+    struct Member;
+
+    Value() : _uint64(0) {}
+
+    Kind kind() const { return (Kind)_kind; }
+
+    // These return a zero value for other kinds
+    bool asBool() const { return _kind == BOOL && _bool; }
+    uint8_t asByte() const { return _kind == BYTE ? _byte : 0; }
+    int32_t asInt() const { return _kind == INT ? _int : 0; }
+    uint32_t asUint() const { return _kind == UINT ? _uint : 0; }
+    float asFloat() const { return _kind == FLOAT ? _float : 0; }
+    String asString() const { return _kind == STRING ? String(_string, _size) : String(); }
+    int64_t asInt64() const { return _kind == INT64 ? _int64 : 0; }
+    uint64_t asUint64() const { return _kind == UINT64 ? _uint64 : 0; }
+
+    // The definition name of enums and objects, and the name of an enum value
+    String typeName() const { return _type ? *_type : String(); }
+    String enumName() const { return _kind == ENUM ? *_enumName : String(); }
+
+    // Elements of arrays and members of objects
+    uint32_t size() const { return _kind == ARRAY || _kind == OBJECT ? _size : 0; }
+    const Value &operator [] (uint32_t index) const { assert(_kind == ARRAY && index < _size); return _elements[index]; }
+    const Member &member(uint32_t index) const;
+    const Value *find(const String &name) const;
+    const Value *find(const char *name) const { return find(String(name)); }
+
+  private:
+    friend class BinarySchema;
+
+    uint8_t _kind = BOOL;
+    uint32_t _size = 0; // The length of strings, or the number of elements or members
+    const String *_type = nullptr;
+
+    union {
+      bool _bool;
+      uint8_t _byte;
+      int32_t _int;
+      uint32_t _uint;
+      float _float;
+      const char *_string;
+      int64_t _int64;
+      uint64_t _uint64;
+      const Value *_elements;
+      const String *_enumName;
+      const Member *_members;
+    };
   };
 
+  struct Value::Member {
+    String name;
+    Value value;
+  };
+
+  inline const Value::Member &Value::member(uint32_t index) const {
+    assert(_kind == OBJECT && index < _size);
+    return _members[index];
+  }
+
   ////////////////////////////////////////////////////////////////////////////////
 
   class BinarySchema {
   public:
     bool parse(ByteBuffer &bb);
-    bool findDefinition(const char *definition, uint32_t &index) const;
+    bool findDefinition(const char *definition, uint32_t &index) const { return findDefinition(String(definition), index); }
+    bool findDefinition(const String &definition, uint32_t &index) const;
     bool skipField(ByteBuffer &bb, uint32_t definition, uint32_t field) const;
 
+    // Skipping uses an explicit stack instead of recursion so that untrusted
+    // input can't overflow the native stack. Input that nests messages, structs
+    // and arrays more than "maxDepth" levels deep fails to skip instead.
+    uint32_t maxDepth() const { return _maxDepth; }
+    void setMaxDepth(uint32_t maxDepth) { _maxDepth = maxDepth; }
+
+    // A fingerprint of one definition: its name, kind, and the names, types,
+    // array flags and values of its fields. Types are compared by name, so
+    // the same definition has the same hash in every schema. This matches the
+    // hashes embedded in generated code.
+    bool definitionHash(uint32_t definition, uint32_t &hash) const;
+
+    // Decodes a value of any struct or message type into a tree of values
+    // allocated in "pool", without any generated code. This recurses on the
+    // native stack, so it fails past MAX_DECODE_DEPTH levels even if the
+    // maximum depth for skipping is higher.
+    enum { MAX_DECODE_DEPTH = 1024 };
+    bool decode(ByteBuffer &bb, uint32_t definition, Value &result, MemoryPool &pool) const;
+
   private:
     enum {
       TYPE_BOOL = -1,
@@ -164,16 +578,163 @@ namespace kiwi {
       KIND_MESSAGE = 2,
     };
 
+    // Skipping a struct runs a flat list of steps instead of dispatching on
+    // every field. Consecutive fields of the same kind are merged into a single
+    // step, and small nested structs are inlined.
+    enum {
+      SKIP_BYTES,
+      SKIP_VARUINTS,
+      SKIP_VARUINT64S,
+      SKIP_FLOATS,
+      SKIP_STRINGS,
+      SKIP_FIELD,
+    };
+
+    struct SkipStep {
+      uint8_t kind = 0;
+      uint32_t count = 0;
+      const Field *field = nullptr; // Only for SKIP_FIELD
+    };
+
     struct Definition {
       String name;
       uint8_t kind = 0;
       Array<Field> fields;
+      Array<uint32_t> fieldTable; // For messages and enums, maps field values to "index + 1"
+      bool isDense = false; // Whether "fieldTable" is indexed by id directly instead of hashed
+      uint8_t planState = 0;
+      Array<SkipStep> skipPlan; // For structs, how to skip over one value
+      uint32_t hash = 0;
+      Array<uint32_t> namePositions; // For decoded objects, each field's position in name order
+    };
+
+    enum { PLAN_NONE, PLAN_COMPILING, PLAN_DONE, MAX_INLINED_STEPS = 8, MAX_PLAN_DEPTH = 64 };
+
+    // One struct or message value being skipped, or an array of them
+    struct SkipFrame {
+      const Field *field;
+      uint32_t remaining;
+      uint32_t step; // The next step in the plan for structs
     };
 
+    enum { DEFAULT_MAX_DEPTH = 1024, INLINE_SKIP_FRAMES = 32, MAX_ZERO_WIDTH_ELEMENTS = 256 };
+
     bool _skipField(ByteBuffer &bb, const Field &field) const;
+    bool _decodeField(ByteBuffer &bb, const Field &field, Value &result, MemoryPool &pool, uint32_t depth) const;
+    bool _decodeValue(ByteBuffer &bb, int32_t type, Value &result, MemoryPool &pool, uint32_t depth) const;
+    void _sortFields(Definition &definition);
+    bool _skipValues(ByteBuffer &bb, uint8_t kind, uint64_t count) const;
+    void _indexFields(Definition &definition);
+    const Field *_findField(const Definition &definition, uint32_t id) const;
+    void _compileSkipPlan(Definition &definition, uint32_t depth);
+    uint32_t _emitSkipPlan(const Definition &definition, SkipStep *steps) const;
+    uint8_t _skipKind(int32_t type) const;
+    uint32_t _hashDefinition(const Definition &definition) const;
+    static uint32_t _hash(const String &name) { return _hashBytes(FNV_OFFSET_BASIS, name.c_str(), name.size()); }
+    static uint32_t _hashBytes(uint32_t hash, const void *data, size_t size);
+    static uint32_t _hashUint32(uint32_t hash, uint32_t value);
+
+    enum : uint32_t { FNV_OFFSET_BASIS = 2166136261u, FNV_PRIME = 16777619u };
 
     MemoryPool _pool;
     Array<Definition> _definitions;
+    Array<uint32_t> _definitionTable; // Open addressing by name hash, stores "index + 1"
+    uint32_t _maxDepth = DEFAULT_MAX_DEPTH;
+  };
+
+  ////////////////////////////////////////////////////////////////////////////////
+
+  // A process-wide cache of parsed schemas keyed by their encoded bytes, so
+  // that many connections sending the same schema share one parsed copy. The
+  // "Schema" type is either kiwi::BinarySchema or a generated BinarySchema,
+  // which also shares its resolved definition indices. Schemas are freed once
+  // nothing references them anymore. This is thread-safe.
+  template <typename Schema>
+  class SchemaCache {
+  public:
+    // Returns nullptr if the schema is invalid
+    static std::shared_ptr<const Schema> parse(const uint8_t *data, size_t size) {
+      uint64_t hash = _hash(data, size);
+      State &state = _state();
+      std::lock_guard<std::mutex> lock(state.mutex);
+      std::shared_ptr<const Schema> result;
+
+      for (Entry **link = &state.entries; *link;) {
+        Entry *entry = *link;
+
+        // Forget about schemas that are no longer used
+        if (entry->schema.expired()) {
+          *link = entry->next;
+          delete entry;
+          continue;
+        }
+
+        if (!result && entry->hash == hash && entry->size == size && !memcmp(entry->data.get(), data, size)) {
+          result = entry->schema.lock();
+        }
+        link = &entry->next;
+      }
+
+      if (result) {
+        return result;
+      }
+
+      // Parsing happens while holding the lock so each schema is only parsed once
+      std::shared_ptr<Schema> schema = std::make_shared<Schema>();
+      ByteBuffer bb(data, size);
+      if (!schema->parse(bb)) {
+        return nullptr;
+      }
+
+      Entry *entry = new Entry;
+      entry->hash = hash;
+      entry->size = size;
+      entry->data.reset(new uint8_t[size]);
+      memcpy(entry->data.get(), data, size);
+      entry->schema = schema;
+      entry->next = state.entries;
+      state.entries = entry;
+      return schema;
+    }
+
+    // The number of distinct schemas that are currently in use
+    static size_t size() {
+      State &state = _state();
+      std::lock_guard<std::mutex> lock(state.mutex);
+      size_t count = 0;
+      for (Entry *entry = state.entries; entry; entry = entry->next) {
+        count += !entry->schema.expired();
+      }
+      return count;
+    }
+
+  private:
+    struct Entry {
+      uint64_t hash = 0;
+      size_t size = 0;
+      std::unique_ptr<uint8_t[]> data;
+      std::weak_ptr<const Schema> schema;
+      Entry *next = nullptr;
+    };
+
+    struct State {
+      std::mutex mutex;
+      Entry *entries = nullptr;
+    };
+
+    static State &_state() {
+      static State state;
+      return state;
+    }
+
+    // FNV-1a
+    static uint64_t _hash(const uint8_t *data, size_t size) {
+      uint64_t hash = 14695981039346656037ULL;
+      for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 1099511628211ULL;
+      }
+      return hash;
+    }
   };
 }
 
@@ -182,7 +743,139 @@ namespace kiwi {
 #ifndef IMPLEMENT_KIWI_H_
 #define IMPLEMENT_KIWI_H_
 
-  kiwi::ByteBuffer::ByteBuffer() : _data(new uint8_t[INITIAL_CAPACITY]), _capacity(INITIAL_CAPACITY), _ownsData(true) {
+  kiwi::Allocator *kiwi::Allocator::standard() {
+    struct Standard : Allocator {
+      void *allocate(size_t size) override { return new uint8_t[size]; }
+      void free(void *data, size_t) override { delete [] static_cast<uint8_t *>(data); }
+    };
+    static Standard allocator;
+    return &allocator;
+  }
+
+  class kiwi::Allocator::ThreadCache {
+  public:
+    ~ThreadCache() { setCapacity(0); }
+
+    void *allocate(size_t size) {
+      if (Bucket *bucket = _find(size)) {
+        if (FreeBlock *block = bucket->blocks) {
+          bucket->blocks = block->next;
+          bucket->lastUse = ++_clock;
+          _cached -= size;
+          return block;
+        }
+      }
+      return standard()->allocate(size);
+    }
+
+    void free(void *data, size_t size) {
+      // Blocks bigger than the largest regular pool chunk are one-offs such as
+      // dedicated chunks, so they aren't worth holding on to
+      if (size < sizeof(FreeBlock) || size > MAX_BLOCK_SIZE || size > _capacity - _cached) {
+        standard()->free(data, size);
+        return;
+      }
+
+      // Claim an empty bucket for a new size, or else recycle the least
+      // recently used one so one-off sizes can't crowd out recurring ones
+      Bucket *bucket = _find(size);
+      if (!bucket) {
+        bucket = &_buckets[0];
+        for (Bucket &other : _buckets) {
+          if (!other.blocks) {
+            bucket = &other;
+            break;
+          }
+          if (other.lastUse < bucket->lastUse) {
+            bucket = &other;
+          }
+        }
+        _evict(*bucket, 0);
+        bucket->size = size;
+      }
+
+      FreeBlock *block = static_cast<FreeBlock *>(data);
+      block->next = bucket->blocks;
+      bucket->blocks = block;
+      bucket->lastUse = ++_clock;
+      _cached += size;
+    }
+
+    void setCapacity(size_t capacity) {
+      _capacity = capacity;
+
+      // Free everything over the new capacity
+      for (Bucket &bucket : _buckets) {
+        _evict(bucket, capacity);
+      }
+    }
+
+    static ThreadCache &current() {
+      static thread_local ThreadCache cache;
+      return cache;
+    }
+
+  private:
+    struct FreeBlock {
+      FreeBlock *next;
+    };
+
+    struct Bucket {
+      size_t size = 0;
+      FreeBlock *blocks = nullptr;
+      uint64_t lastUse = 0;
+    };
+
+    // Frees blocks from "bucket" until at most "capacity" bytes are cached
+    void _evict(Bucket &bucket, size_t capacity) {
+      while (_cached > capacity && bucket.blocks) {
+        FreeBlock *block = bucket.blocks;
+        bucket.blocks = block->next;
+        _cached -= bucket.size;
+        standard()->free(block, bucket.size);
+      }
+    }
+
+    Bucket *_find(size_t size) {
+      for (Bucket &bucket : _buckets) {
+        if (bucket.size == size) return &bucket;
+      }
+      return nullptr;
+    }
+
+    enum { BUCKET_COUNT = 16, DEFAULT_CAPACITY = 1 << 22, MAX_BLOCK_SIZE = (1 << 20) + 256 };
+    Bucket _buckets[BUCKET_COUNT];
+    size_t _capacity = DEFAULT_CAPACITY;
+    size_t _cached = 0;
+    uint64_t _clock = 0;
+  };
+
+  kiwi::Allocator *kiwi::Allocator::threadCache() {
+    // The allocator itself is stateless so that pools can be freed on any thread
+    struct Cached : Allocator {
+      void *allocate(size_t size) override { return ThreadCache::current().allocate(size); }
+      void free(void *data, size_t size) override { ThreadCache::current().free(data, size); }
+    };
+    static Cached allocator;
+    return &allocator;
+  }
+
+  void kiwi::Allocator::setThreadCacheCapacity(size_t capacity) {
+    ThreadCache::current().setCapacity(capacity);
+  }
+
+#ifdef KIWI_STATISTICS
+  kiwi::StatisticsHooks &kiwi::statisticsHooks() {
+    static StatisticsHooks hooks;
+    return hooks;
+  }
+#endif
+
+  ////////////////////////////////////////////////////////////////////////////////
+
+  kiwi::ByteBuffer::ByteBuffer(Allocator *allocator) : _capacity(INITIAL_CAPACITY), _ownsData(true), _allocator(allocator) {
+    assert(allocator);
+    _data = static_cast<uint8_t *>(allocator->allocate(INITIAL_CAPACITY));
   }
 
   kiwi::ByteBuffer::ByteBuffer(uint8_t *data, size_t size) : _data(data), _size(size), _capacity(size) {
@@ -193,9 +886,126 @@ namespace kiwi {
   }
 
   kiwi::ByteBuffer::~ByteBuffer() {
+  #ifdef KIWI_STATISTICS
+    if (statisticsHooks().byteBuffer) {
+      statisticsHooks().byteBuffer(statistics());
+    }
+  #endif
+
+    if (_ownsData) {
+      _allocator->free(_data, _capacity);
+    }
+
+  #ifdef KIWI_HAS_FILE_DESCRIPTORS
+    if (_isMapped) {
+      munmap(_data, _size);
+    }
+  #endif
+
+    for (Segment *segment = _firstSegment, *next; segment; segment = next) {
+      next = segment->next;
+      _allocator->free(segment->data, segment->capacity);
+      delete segment;
+    }
+  }
+
+  void kiwi::ByteBuffer::setSource(Source source, void *context, size_t blockSize) {
+    assert(!_isConst && _size == 0 && source && blockSize > 0);
+
+    if (_ownsData) {
+      _allocator->free(_data, _capacity);
+    }
+
+    _data = static_cast<uint8_t *>(_allocator->allocate(blockSize));
+    _capacity = blockSize;
+    _blockSize = blockSize;
+    _ownsData = true;
+    _source = source;
+    _sourceContext = context;
+  }
+
+  void kiwi::ByteBuffer::setSource(FILE *file, size_t blockSize) {
+    setSource([](void *context, uint8_t *data, size_t size) -> size_t {
+      return fread(data, 1, size, static_cast<FILE *>(context));
+    }, file, blockSize);
+  }
+
+#ifdef KIWI_HAS_FILE_DESCRIPTORS
+  void kiwi::ByteBuffer::setSource(int fd, size_t blockSize) {
+    setSource([](void *context, uint8_t *data, size_t size) -> size_t {
+      while (true) {
+        ssize_t count = read(static_cast<int>(reinterpret_cast<intptr_t>(context)), data, size);
+        if (count >= 0) return count;
+        if (errno != EINTR) return 0;
+      }
+    }, reinterpret_cast<void *>(static_cast<intptr_t>(fd)), blockSize);
+  }
+
+  bool kiwi::ByteBuffer::mapFile(const char *path, bool populate) {
+    assert(!_isConst && _size == 0);
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+
+    // Only regular files have a meaningful size to map. Files that report a
+    // size of 0 but still have contents (e.g. in procfs) are rejected too.
+    struct stat info;
+    uint8_t byte;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || (info.st_size == 0 && read(fd, &byte, 1) != 0)) {
+      close(fd);
+      return false;
+    }
+
+    // Mapping an empty file isn't allowed, so leave the buffer empty instead
+    void *data = nullptr;
+    size_t size = info.st_size;
+    if (size > 0) {
+      int flags = MAP_PRIVATE;
+    #ifdef MAP_POPULATE
+      if (populate) flags |= MAP_POPULATE;
+    #else
+      (void)populate;
+    #endif
+      data = mmap(nullptr, size, PROT_READ, flags, fd, 0);
+    }
+    close(fd);
+
+    if (data == MAP_FAILED) {
+      return false;
+    }
+
+    if (data) {
+      madvise(data, size, MADV_SEQUENTIAL);
+    }
+
     if (_ownsData) {
-      delete [] _data;
+      _allocator->free(_data, _capacity);
+    }
+
+    _data = static_cast<uint8_t *>(data);
+    _size = size;
+    _capacity = size;
+    _ownsData = false;
+    _isConst = true;
+    _isMapped = data != nullptr;
+    return true;
+  }
+
+#endif
+
+  void kiwi::ByteBuffer::setSegmentSize(size_t segmentSize) {
+    assert(!_isConst && _size == 0 && segmentSize > 0);
+    _segmentSize = segmentSize;
+  }
+
+  size_t kiwi::ByteBuffer::segmentCount() const {
+    size_t count = _size > 0;
+    for (Segment *segment = _firstSegment; segment; segment = segment->next) {
+      count++;
     }
+    return count;
   }
 
   bool kiwi::ByteBuffer::readByte(bool &result) {
@@ -210,7 +1020,7 @@ namespace kiwi {
   }
 
   bool kiwi::ByteBuffer::readByte(uint8_t &result) {
-    if (_index >= _size) {
+    if (_index >= _size && !_refill(1)) {
       result = 0;
       return false;
     }
@@ -233,7 +1043,7 @@ namespace kiwi {
     }
 
     // Endian-independent 32-bit read
-    if (_index + 3 > _size) {
+    if (_index + 3 > _size && !_refill(3)) {
       result = 0;
       return false;
     }
@@ -248,7 +1058,62 @@ namespace kiwi {
     return true;
   }
 
+  // Loads the next 8 bytes as a little-endian integer. There must be at least
+  // 8 bytes left in the buffer. This is used to decode a whole varint at once.
+  uint64_t kiwi::ByteBuffer::_peekUint64() const {
+    uint64_t bytes;
+    memcpy(&bytes, _data + _index, 8);
+  #if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    bytes = __builtin_bswap64(bytes);
+  #endif
+    return bytes;
+  }
+
+  // Packs the low 7 bits of each of the 8 bytes together into a 56-bit value
+  uint64_t kiwi::ByteBuffer::_compactVarBytes(uint64_t bytes) {
+    bytes = ((bytes & 0x7F007F007F007F00ULL) >> 1) | (bytes & 0x007F007F007F007FULL);
+    bytes = ((bytes & 0x3FFF00003FFF0000ULL) >> 2) | (bytes & 0x00003FFF00003FFFULL);
+    bytes = ((bytes & 0x0FFFFFFF00000000ULL) >> 4) | (bytes & 0x000000000FFFFFFFULL);
+    return bytes;
+  }
+
+  // Returns the number of bytes up to and including the first byte whose bit is
+  // set in "stopBits", which must only contain bits from the "0x80" positions
+  uint32_t kiwi::ByteBuffer::_varByteCount(uint64_t stopBits) {
+    assert(stopBits != 0);
+  #if defined(__GNUC__) || defined(__clang__)
+    return (__builtin_ctzll(stopBits) >> 3) + 1;
+  #else
+    uint32_t count = 1;
+    while (!(stopBits & 0x80)) {
+      stopBits >>= 8;
+      count++;
+    }
+    return count;
+  #endif
+  }
+
   bool kiwi::ByteBuffer::readVarUint(uint32_t &result) {
+    // Optimization: decode from a single 64-bit load when not near the end
+    if (_size - _index >= 8) {
+      uint64_t bytes = _peekUint64();
+
+      // Single-byte values are the most common case
+      if (!(bytes & 0x80)) {
+        result = bytes & 127;
+        _index++;
+        return true;
+      }
+
+      // The value ends at the first byte without the continuation bit, or
+      // after 5 bytes regardless (the same as the byte-at-a-time loop below)
+      uint64_t stopBits = ~bytes & 0x0000008080808080ULL;
+      uint32_t count = stopBits ? _varByteCount(stopBits) : 5;
+      result = (uint32_t)_compactVarBytes(bytes & (~0ULL >> (64 - count * 8)));
+      _index += count;
+      return true;
+    }
+
     uint8_t shift = 0;
     uint8_t byte;
     result = 0;
@@ -277,70 +1142,298 @@ namespace kiwi {
   }
 
   bool kiwi::ByteBuffer::readString(const char *&result) {
-    result = reinterpret_cast<const char *>(_data) + _index;
+    size_t scanned = 0;
 
-    do {
-      if (_index >= _size) return false;
-    } while (_data[_index++] != '\0');
+    // Use memchr to find the null terminator since it's vectorized
+    const void *end = _index < _size ? memchr(_data + _index, '\0', _size - _index) : nullptr;
+
+    // Keep reading from a streaming source until the terminator shows up
+    while (!end) {
+      scanned = _size - _index;
+      if (!_refill(scanned + 1)) {
+        result = reinterpret_cast<const char *>(_data) + _index;
+        _index = _size;
+        return false;
+      }
+      end = memchr(_data + _index + scanned, '\0', _size - _index - scanned);
+    }
 
+    result = reinterpret_cast<const char *>(_data) + _index;
+    _index = static_cast<const uint8_t *>(end) - _data + 1;
     return true;
   }
 
   bool kiwi::ByteBuffer::readString(String &result, MemoryPool &pool) {
-    uint32_t size = 0;
+    const char *c_str;
     result = String();
 
-    do {
-      if (_index >= _size) return false;
-    } while (_data[_index + size++] != '\0');
+    if (!readString(c_str)) {
+      return false;
+    }
 
-    result = pool.string(reinterpret_cast<char *>(_data + _index), size - 1);
-    _index += size;
+    result = pool.string(c_str, reinterpret_cast<const char *>(_data) + _index - 1 - c_str);
     return true;
   }
 
-  bool kiwi::ByteBuffer::readVarUint64(uint64_t &result) {
-    uint8_t shift = 0;
-    uint8_t byte;
-    result = 0;
+  // The result points directly into this buffer instead of being copied, so the
+  // buffer's data must outlive the string and must not be written to meanwhile
+  bool kiwi::ByteBuffer::readBorrowedString(String &result) {
+    const char *c_str;
+    result = String();
+    assert(!_source);
 
-    while (true) {
-      if (!readByte(byte)) {
-        return false;
-      }
-      if (!(byte & 128) || shift >= 56) {
-        break;
-      }
-      result |= (uint64_t)(byte & 127) << shift;
-      shift += 7;
+    if (!readString(c_str)) {
+      return false;
     }
 
-    result |= (uint64_t)(byte) << shift;
+    result = String(c_str, reinterpret_cast<const char *>(_data) + _index - 1 - c_str);
     return true;
   }
 
-  bool kiwi::ByteBuffer::readVarInt64(int64_t &result) {
-    uint64_t value;
-    if (!readVarUint64(value)) {
-      result = 0;
+  // The result points directly into this buffer instead of being copied
+  bool kiwi::ByteBuffer::readBytes(const uint8_t *&result, uint32_t count) {
+    if (count > _size - _index && !_refill(count)) {
+      result = nullptr;
       return false;
     }
 
-    result = value & 1 ? ~(value >> 1) : value >> 1;
+    result = _data + _index;
+    _index += count;
     return true;
   }
 
-  void kiwi::ByteBuffer::writeByte(uint8_t value) {
-    assert(!_isConst);
-    size_t index = _size;
-    _growBy(1);
-    _data[index] = value;
+  // Like readBytes(), but the caller keeps the pointer instead of copying the
+  // bytes, so the buffer's data must outlive the result
+  bool kiwi::ByteBuffer::readBorrowedBytes(const uint8_t *&result, uint32_t count) {
+    assert(!_source);
+    return readBytes(result, count);
   }
 
-  void kiwi::ByteBuffer::writeVarFloat(float value) {
-    assert(!_isConst);
+  // Skips whole windows of a streaming source instead of growing the window to
+  // hold all of the skipped bytes at once
+  bool kiwi::ByteBuffer::skipBytes(uint64_t count) {
+    while (count > _size - _index) {
+      count -= _size - _index;
+      _index = _size;
+      if (!_refill(1)) {
+        return false;
+      }
+    }
 
-    // Reinterpret as an integer
+    _index += count;
+    return true;
+  }
+
+  bool kiwi::ByteBuffer::readVarUint64(uint64_t &result) {
+    // Optimization: decode from a single 64-bit load when not near the end
+    if (_size - _index >= 8) {
+      uint64_t bytes = _peekUint64();
+
+      // Single-byte values are the most common case
+      if (!(bytes & 0x80)) {
+        result = bytes & 127;
+        _index++;
+        return true;
+      }
+
+      uint64_t stopBits = ~bytes & 0x8080808080808080ULL;
+      if (stopBits) {
+        uint32_t count = _varByteCount(stopBits);
+        result = _compactVarBytes(count == 8 ? bytes : bytes & ((1ULL << (count * 8)) - 1));
+        _index += count;
+        return true;
+      }
+
+      // All 8 bytes have the continuation bit, so the 9th byte is stored whole
+      if (_size - _index >= 9) {
+        result = _compactVarBytes(bytes) | (uint64_t)_data[_index + 8] << 56;
+        _index += 9;
+        return true;
+      }
+    }
+
+    uint8_t shift = 0;
+    uint8_t byte;
+    result = 0;
+
+    while (true) {
+      if (!readByte(byte)) {
+        return false;
+      }
+      if (!(byte & 128) || shift >= 56) {
+        break;
+      }
+      result |= (uint64_t)(byte & 127) << shift;
+      shift += 7;
+    }
+
+    result |= (uint64_t)(byte) << shift;
+    return true;
+  }
+
+  bool kiwi::ByteBuffer::readVarInt64(int64_t &result) {
+    uint64_t value;
+    if (!readVarUint64(value)) {
+      result = 0;
+      return false;
+    }
+
+    result = value & 1 ? ~(value >> 1) : value >> 1;
+    return true;
+  }
+
+  bool kiwi::ByteBuffer::readVarUintArray(uint32_t *result, uint32_t count) {
+    uint32_t i = 0;
+
+    // Optimization: arrays of small values are mostly single-byte varints, so
+    // copy each run of them out of a 64-bit load without decoding one at a time
+    while (count - i >= 8 && _size - _index >= 8) {
+      uint64_t bytes = _peekUint64();
+      uint64_t continuationBits = bytes & 0x8080808080808080ULL;
+      uint32_t run = continuationBits ? _varByteCount(continuationBits) - 1 : 8;
+
+      for (uint32_t j = 0; j < run; j++) {
+        result[i + j] = (bytes >> (j * 8)) & 127;
+      }
+      i += run;
+      _index += run;
+
+      if (run == 8) {
+        continue;
+      }
+
+      // Decode the longer value after the run from the same load. Bytes past
+      // the end of the load shift in as zeros, which look like a stop byte, so
+      // a value that doesn't fit is left for the next load instead.
+      uint64_t rest = bytes >> (run * 8);
+      uint64_t stopBits = ~rest & 0x0000008080808080ULL;
+      uint32_t size = stopBits ? _varByteCount(stopBits) : 5;
+      if (run + size <= 8) {
+        result[i++] = (uint32_t)_compactVarBytes(rest & (~0ULL >> (64 - size * 8)));
+        _index += size;
+      }
+    }
+
+    for (; i < count; i++) {
+      if (!readVarUint(result[i])) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  bool kiwi::ByteBuffer::skipVarUints(uint64_t count) {
+    // Optimization: skip each run of single-byte varints all at once
+    while (count >= 8 && _size - _index >= 8) {
+      uint64_t continuationBits = _peekUint64() & 0x8080808080808080ULL;
+      uint32_t run = continuationBits ? _varByteCount(continuationBits) - 1 : 8;
+      count -= run;
+      _index += run;
+
+      uint32_t dummy;
+      if (run < 8 && (count--, !readVarUint(dummy))) {
+        return false;
+      }
+    }
+
+    for (uint32_t dummy; count > 0; count--) {
+      if (!readVarUint(dummy)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  bool kiwi::ByteBuffer::readVarIntArray(int32_t *result, uint32_t count) {
+    uint32_t *values = reinterpret_cast<uint32_t *>(result);
+    if (!readVarUintArray(values, count)) {
+      return false;
+    }
+
+    // Undo the zigzag encoding in a separate pass so it can be vectorized
+    for (uint32_t i = 0; i < count; i++) {
+      values[i] = (values[i] >> 1) ^ -(values[i] & 1);
+    }
+
+    return true;
+  }
+
+  void kiwi::ByteBuffer::writeByte(uint8_t value) {
+    uint8_t *out = beginWrite(1);
+    *out++ = value;
+    endWrite(out);
+  }
+
+  // The checked writers only ask for the exact size when the worst case
+  // doesn't fit, so an exact reservation from encodedSize() is never outgrown
+  void kiwi::ByteBuffer::writeVarFloat(float value) {
+    uint8_t *out = beginWrite(_capacity - _size < 4 ? varFloatSize(value) : 4);
+    putVarFloat(out, value);
+    endWrite(out);
+  }
+
+  void kiwi::ByteBuffer::writeVarUint(uint32_t value) {
+    uint8_t *out = beginWrite(_capacity - _size < 5 ? varUintSize(value) : 5);
+    putVarUint(out, value);
+    endWrite(out);
+  }
+
+  void kiwi::ByteBuffer::writeVarInt(int32_t value) {
+    writeVarUint((value << 1) ^ (value >> 31));
+  }
+
+  void kiwi::ByteBuffer::writeVarUint64(uint64_t value) {
+    uint8_t *out = beginWrite(_capacity - _size < 9 ? varUint64Size(value) : 9);
+    putVarUint64(out, value);
+    endWrite(out);
+  }
+
+  void kiwi::ByteBuffer::writeVarInt64(int64_t value) {
+    writeVarUint64((value << 1) ^ (value >> 63));
+  }
+
+  void kiwi::ByteBuffer::writeString(const char *value) {
+    writeBytes(reinterpret_cast<const uint8_t *>(value), strlen(value) + 1);
+  }
+
+  void kiwi::ByteBuffer::writeString(const String &value) {
+    uint32_t count = value.size();
+    uint8_t *out = beginWrite(count + 1);
+    if (count) memcpy(out, value.c_str(), count);
+    out[count] = '\0';
+    endWrite(out + count + 1);
+  }
+
+  void kiwi::ByteBuffer::writeBytes(const uint8_t *data, size_t count) {
+    uint8_t *out = beginWrite(count);
+    if (count) memcpy(out, data, count);
+    endWrite(out + count);
+  }
+
+  uint8_t *kiwi::ByteBuffer::beginWrite(size_t amount) {
+    if (_size + amount > _capacity) {
+      _makeRoom(amount, _capacity * 2 > _size + amount ? _capacity * 2 : _size + amount);
+    }
+
+    return _data + _size;
+  }
+
+  void kiwi::ByteBuffer::endWrite(uint8_t *end) {
+    assert(end >= _data + _size && end <= _data + _capacity);
+    _size = end - _data;
+  }
+
+  size_t kiwi::ByteBuffer::writeBatchSize(size_t count, size_t maxSize) const {
+    size_t room = _capacity - _size;
+    if (room > 0 && room < maxSize) return 0;
+    if (room >= maxSize && count > room / maxSize) count = room / maxSize;
+    return count < WRITE_BATCH ? count : (size_t)WRITE_BATCH;
+  }
+
+  void kiwi::ByteBuffer::putVarFloat(uint8_t *&out, float value) {
+    // Reinterpret as an integer
     uint32_t bits;
     memcpy(&bits, &value, 4);
 
@@ -349,115 +1442,488 @@ namespace kiwi {
 
     // Optimization: use a single byte to store zero and denormals (check for an exponent of 0)
     if ((bits & 255) == 0) {
-      writeByte(0);
+      *out++ = 0;
       return;
     }
 
     // Endian-independent 32-bit write
-    size_t index = _size;
-    _growBy(4);
-    _data[index] = bits;
-    _data[index + 1] = bits >> 8;
-    _data[index + 2] = bits >> 16;
-    _data[index + 3] = bits >> 24;
+    out[0] = bits;
+    out[1] = bits >> 8;
+    out[2] = bits >> 16;
+    out[3] = bits >> 24;
+    out += 4;
   }
 
-  void kiwi::ByteBuffer::writeVarUint(uint32_t value) {
-    assert(!_isConst);
-    do {
-      uint8_t byte = value & 127;
+  void kiwi::ByteBuffer::putVarUint(uint8_t *&out, uint32_t value) {
+    while (value > 127) {
+      *out++ = (value & 127) | 128;
       value >>= 7;
-      writeByte(value ? byte | 128 : byte);
-    } while (value);
+    }
+    *out++ = value;
   }
 
-  void kiwi::ByteBuffer::writeVarInt(int32_t value) {
-    assert(!_isConst);
-    writeVarUint((value << 1) ^ (value >> 31));
+  void kiwi::ByteBuffer::putVarUint64(uint8_t *&out, uint64_t value) {
+    for (int i = 0; value > 127 && i < 8; i++) {
+      *out++ = (value & 127) | 128;
+      value >>= 7;
+    }
+    *out++ = value;
   }
 
-  void kiwi::ByteBuffer::writeVarUint64(uint64_t value) {
-    assert(!_isConst);
+  void kiwi::ByteBuffer::reserve(size_t amount) {
+    if (_size + amount > _capacity) {
+      _makeRoom(amount, _size + amount);
+    }
+  }
+
+  size_t kiwi::ByteBuffer::varFloatSize(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, 4);
+
+    // Zero and denormals (an exponent of 0) are stored using a single byte
+    return (bits & 0x7F800000) == 0 ? 1 : 4;
+  }
+
+  size_t kiwi::ByteBuffer::varUint64Size(uint64_t value) {
+    size_t size = 1;
     for (int i = 0; value > 127 && i < 8; i++) {
-      writeByte((value & 127) | 128);
       value >>= 7;
+      size++;
     }
-    writeByte(value);
+    return size;
   }
 
-  void kiwi::ByteBuffer::writeVarInt64(int64_t value) {
-    assert(!_isConst);
-    writeVarUint64((value << 1) ^ (value >> 63));
+  // Makes sure at least "amount" unread bytes are available from a streaming
+  // source, and returns false if the input ends before that
+  bool kiwi::ByteBuffer::_refill(size_t amount) {
+    if (!_source) {
+      return false;
+    }
+
+    // Discard everything that was already read, except for pinned bytes
+    uint8_t *data = _data;
+    size_t discard = _isPinned && _pinned - _offset < _index ? _pinned - _offset : _index;
+    size_t available = _size - discard;
+    memmove(_data, _data + discard, available);
+  #ifdef KIWI_STATISTICS
+    _refills++;
+    _copiedBytes += available;
+  #endif
+    _offset += discard;
+    _index -= discard;
+    _size = available;
+    amount += _index;
+
+    // Shrink the window back down once a large read has been consumed
+    if (_capacity > _blockSize && amount <= _blockSize && available <= _blockSize) {
+      _reallocate(_blockSize);
+    }
+
+    // Read as much as fits, not just what's needed, to read in large blocks.
+    // The window only grows as the data actually arrives so a hostile length
+    // can't force a large allocation up front.
+    while (_size < amount) {
+      if (_size == _capacity) {
+        _reallocate(amount - _capacity < _capacity ? amount : _capacity * 2);
+      }
+      size_t count = _source(_sourceContext, _data + _size, _capacity - _size);
+      if (!count) {
+        return false;
+      }
+      _size += count;
+    }
+
+    if (_isPinned && (discard > 0 || _data != data)) {
+      _pinMoved = true;
+    }
+    return true;
   }
 
-  void kiwi::ByteBuffer::writeString(const char *value) {
-    assert(!_isConst);
-    uint32_t count = strlen(value) + 1;
-    size_t index = _size;
-    _growBy(count);
-    memcpy(_data + index, value, count);
+  size_t kiwi::ByteBuffer::pin() {
+    assert(!_isPinned);
+    _isPinned = true;
+    _pinMoved = false;
+    _pinned = index();
+    return _pinned;
   }
 
-  void kiwi::ByteBuffer::_growBy(size_t amount) {
+  bool kiwi::ByteBuffer::unpin() {
+    assert(_isPinned);
+    _isPinned = false;
+    return _pinMoved;
+  }
+
+  void kiwi::ByteBuffer::seek(size_t index) {
+    assert(index >= _offset && index - _offset <= _size);
+    _index = index - _offset;
+  }
+
+  void kiwi::ByteBuffer::_makeRoom(size_t amount, size_t capacity) {
     assert(!_isConst);
 
-    if (_size + amount > _capacity) {
-      size_t capacity = (_size + amount) * 2;
-      uint8_t *data = new uint8_t[capacity];
-      memcpy(data, _data, _size);
+    if (_segmentSize) {
+      _startSegment(amount > _segmentSize ? amount : _segmentSize);
+    } else {
+      _reallocate(capacity);
+    }
+  }
 
-      if (_ownsData) {
-        delete [] _data;
-      }
+  void kiwi::ByteBuffer::_reallocate(size_t capacity) {
+    uint8_t *data = static_cast<uint8_t *>(_allocator->allocate(capacity));
+    memcpy(data, _data, _size);
+  #ifdef KIWI_STATISTICS
+    _reallocations++;
+    _copiedBytes += _size;
+  #endif
 
-      _data = data;
-      _capacity = capacity;
-      _ownsData = true;
+    if (_ownsData) {
+      _allocator->free(_data, _capacity);
+    }
+
+    _data = data;
+    _capacity = capacity;
+    _ownsData = true;
+  }
+
+  void kiwi::ByteBuffer::_startSegment(size_t capacity) {
+    // Retire the current segment instead of copying it
+    if (_size > 0) {
+      assert(_ownsData);
+      Segment *segment = new Segment;
+      segment->data = _data;
+      segment->size = _size;
+      segment->capacity = _capacity;
+
+      if (_lastSegment) _lastSegment->next = segment;
+      else _firstSegment = segment;
+      _lastSegment = segment;
+
+      _offset += _size;
+      _size = 0;
     }
 
-    _size += amount;
+    else if (_ownsData) {
+      _allocator->free(_data, _capacity);
+    }
+
+    _data = static_cast<uint8_t *>(_allocator->allocate(capacity));
+    _capacity = capacity;
+    _ownsData = true;
   }
 
+#ifdef KIWI_STATISTICS
+  kiwi::ByteBufferStatistics kiwi::ByteBuffer::statistics() const {
+    ByteBufferStatistics result;
+    result.size = size();
+    result.capacity = _ownsData ? _capacity : 0;
+    result.segments = segmentCount();
+    for (Segment *segment = _firstSegment; segment; segment = segment->next) {
+      result.capacity += segment->capacity;
+    }
+    result.reallocations = _reallocations;
+    result.copiedBytes = _copiedBytes;
+    result.refills = _refills;
+    return result;
+  }
+#endif
+
   ////////////////////////////////////////////////////////////////////////////////
 
+  kiwi::MemoryPool::MemoryPool(uint32_t initialCapacity, uint32_t maxCapacity, Allocator *allocator)
+      : _initialCapacity(initialCapacity), _maxCapacity(maxCapacity), _nextCapacity(initialCapacity), _allocator(allocator) {
+    assert(initialCapacity > 0 && initialCapacity <= maxCapacity && allocator);
+  }
+
+  kiwi::MemoryPool::~MemoryPool() {
+  #ifdef KIWI_STATISTICS
+    if (statisticsHooks().memoryPool) {
+      statisticsHooks().memoryPool(statistics());
+    }
+  #endif
+
+    clear();
+  }
+
   void kiwi::MemoryPool::clear() {
+  #ifdef KIWI_STATISTICS
+    _updatePeak();
+  #endif
+
+    _deleteChunks(_inline ? _inline->next : _first);
+    _deleteChunks(_large);
+
+    // The inline chunk is never freed, so the pool always starts with it
+    if (_inline) {
+      _inline->used = 0;
+      _inline->next = nullptr;
+    }
+
+    _first = _last = _current = _inline;
+    _large = nullptr;
+    _nextCapacity = _initialCapacity;
+
+  #ifdef KIWI_STATISTICS
+    _recountUsage();
+  #endif
+  }
+
+  void kiwi::MemoryPool::_setInlineChunk(uint8_t *data, size_t size) {
+    clear();
+    _first = _last = _current = _inline = nullptr;
+
+    if (data) {
+      assert(size > sizeof(Chunk));
+      Chunk *chunk = new (data) Chunk;
+      chunk->data = data + sizeof(Chunk);
+      chunk->capacity = size - sizeof(Chunk);
+      _first = _last = _current = _inline = chunk;
+    }
+  }
+
+  void kiwi::MemoryPool::reset(size_t maxRetained) {
+  #ifdef KIWI_STATISTICS
+    _updatePeak();
+  #endif
+
+    size_t retained = 0;
+    Chunk *last = nullptr;
+
     for (Chunk *chunk = _first, *next; chunk; chunk = next) {
       next = chunk->next;
-      delete [] chunk->data;
-      delete chunk;
+
+      // The inline chunk doesn't count against the budget since it can't be freed
+      if (chunk == _inline || chunk->capacity <= maxRetained - retained) {
+        chunk->used = 0;
+        if (chunk != _inline) retained += chunk->capacity;
+        last = chunk;
+      }
+
+      // Chunks are in order of increasing size, so stop at the first one that doesn't fit
+      else {
+        if (last) last->next = nullptr;
+        else _first = nullptr;
+        _deleteChunks(chunk);
+        break;
+      }
+    }
+
+    // Dedicated chunks for large allocations are never reused
+    _deleteChunks(_large);
+
+    _last = last;
+    _current = _first;
+    _large = nullptr;
+
+  #ifdef KIWI_STATISTICS
+    _recountUsage();
+  #endif
+  }
+
+  void kiwi::MemoryPool::rollback(const Mark &mark) {
+  #ifdef KIWI_STATISTICS
+    _updatePeak();
+  #endif
+
+    Chunk *large = static_cast<Chunk *>(mark.large);
+    while (_large != large) {
+      assert(_large);
+      Chunk *next = _large->next;
+      _large->next = nullptr;
+      _deleteChunks(_large);
+      _large = next;
     }
 
-    _first = _last = nullptr;
+    _current = static_cast<Chunk *>(mark.chunk);
+    if (_current) {
+      _current->used = mark.used;
+    }
+
+  #ifdef KIWI_STATISTICS
+    _recountUsage();
+  #endif
   }
 
   template <typename T>
   T *kiwi::MemoryPool::allocate(uint32_t count) {
-    Chunk *chunk = _last;
-    uint32_t size = count * sizeof(T);
-    uint32_t index = (chunk ? chunk->used : 0) + alignof(T) - 1;
-    index -= index % alignof(T);
+    size_t size = (size_t)count * sizeof(T);
+    uint8_t *data = _allocate(size, alignof(T));
+    memset(data, 0, size);
+    return reinterpret_cast<T *>(data);
+  }
+
+  template <typename T>
+  T *kiwi::MemoryPool::allocateUninitialized(uint32_t count) {
+    static_assert(std::is_trivially_default_constructible<T>::value, "Only trivial types can be left uninitialized");
+    return reinterpret_cast<T *>(_allocate((size_t)count * sizeof(T), alignof(T)));
+  }
+
+  template <typename T>
+  kiwi::Array<T> kiwi::MemoryPool::array(const T *data, uint32_t size) {
+    Array<T> result = arrayUninitialized<T>(size);
+    if (size) memcpy(result.data(), data, size * sizeof(T));
+    return result;
+  }
+
+  uint8_t *kiwi::MemoryPool::_allocate(size_t size, size_t alignment) {
+    Chunk *chunk = _current;
 
-    if (chunk && index + size >= index && index + size <= chunk->capacity) {
-      chunk->used = index + size;
-      return reinterpret_cast<T *>(chunk->data + index);
+    if (chunk) {
+      size_t index = chunk->used + alignment - 1;
+      index -= index % alignment;
+
+      if (index <= chunk->capacity && size <= chunk->capacity - index) {
+        chunk->used = index + size;
+        return chunk->data + index;
+      }
+    }
+
+    return _allocateChunk(size);
+  }
+
+  uint8_t *kiwi::MemoryPool::_allocateChunk(size_t size) {
+    // Move on to the next chunk kept by reset() if there is one
+    Chunk *next = _current ? _current->next : _first;
+
+  #ifdef KIWI_STATISTICS
+    _updatePeak();
+  #endif
+
+    if (next && size <= next->capacity) {
+    #ifdef KIWI_STATISTICS
+      _retireCurrent();
+    #endif
+      next->used = size;
+      _current = next;
+      return next->data;
+    }
+
+    Chunk *chunk;
+
+    // Large allocations get a dedicated chunk so the rest of the current
+    // chunk can still be used for the allocations that come after them. This
+    // also applies to allocations that don't fit in the next kept chunk.
+    if (next || size >= _nextCapacity / 2) {
+      chunk = _newChunk(size);
+      chunk->next = _large;
+      _large = chunk;
+    #ifdef KIWI_STATISTICS
+      _retiredUsed += size;
+    #endif
+    }
+
+    // Otherwise start a new chunk, growing geometrically to reduce the number
+    // of chunks needed for a large decode
+    else {
+    #ifdef KIWI_STATISTICS
+      _retireCurrent();
+    #endif
+      chunk = _newChunk(_nextCapacity);
+      _nextCapacity = _nextCapacity * 2 < _maxCapacity ? _nextCapacity * 2 : _maxCapacity;
+
+      if (_last) _last->next = chunk;
+      else _first = chunk;
+      _last = _current = chunk;
     }
 
-    chunk = new Chunk;
-    chunk->capacity = size > INITIAL_CAPACITY ? size : INITIAL_CAPACITY;
-    chunk->data = new uint8_t[chunk->capacity](); // "()" means zero-initialized
     chunk->used = size;
+    return chunk->data;
+  }
 
-    if (_last) _last->next = chunk;
-    else _first = chunk;
-    _last = chunk;
+  kiwi::MemoryPool::Chunk *kiwi::MemoryPool::_newChunk(size_t capacity) {
+    // The chunk header and its data share a single allocation. The header is
+    // four words long, so the data keeps the allocation's alignment.
+    static_assert(sizeof(Chunk) % (2 * sizeof(void *)) == 0, "Chunk data must stay aligned");
+    uint8_t *block = static_cast<uint8_t *>(_allocator->allocate(sizeof(Chunk) + capacity));
+    Chunk *chunk = new (block) Chunk;
+    chunk->data = block + sizeof(Chunk);
+    chunk->capacity = capacity;
+
+  #ifdef KIWI_STATISTICS
+    _chunkCount++;
+    _chunkAllocations++;
+    _reserved += capacity;
+  #endif
+
+    return chunk;
+  }
 
-    return reinterpret_cast<T *>(chunk->data);
+  void kiwi::MemoryPool::_deleteChunks(Chunk *chunk) {
+    for (Chunk *next; chunk; chunk = next) {
+      next = chunk->next;
+    #ifdef KIWI_STATISTICS
+      _chunkCount--;
+      _reserved -= chunk->capacity;
+    #endif
+      _allocator->free(chunk, sizeof(Chunk) + chunk->capacity);
+    }
+  }
+
+#ifdef KIWI_STATISTICS
+  kiwi::MemoryPoolStatistics kiwi::MemoryPool::statistics() const {
+    _updatePeak();
+
+    MemoryPoolStatistics result;
+    result.chunks = _chunkCount;
+    result.reservedBytes = _reserved;
+    result.usedBytes = _retiredUsed + (_current ? _current->used : 0);
+    result.wastedBytes = _retiredWasted;
+    result.peakUsedBytes = _peakUsed;
+    result.peakReservedBytes = _peakReserved;
+    result.chunkAllocations = _chunkAllocations;
+    return result;
+  }
+
+  void kiwi::MemoryPool::_updatePeak() const {
+    size_t used = _retiredUsed + (_current ? _current->used : 0);
+    if (used > _peakUsed) _peakUsed = used;
+    if (_reserved > _peakReserved) _peakReserved = _reserved;
+  }
+
+  void kiwi::MemoryPool::_retireCurrent() {
+    if (_current) {
+      _retiredUsed += _current->used;
+      _retiredWasted += _current->capacity - _current->used;
+    }
+  }
+
+  void kiwi::MemoryPool::_recountUsage() {
+    _retiredUsed = 0;
+    _retiredWasted = 0;
+
+    for (Chunk *chunk = _current ? _first : nullptr; chunk != _current; chunk = chunk->next) {
+      _retiredUsed += chunk->used;
+      _retiredWasted += chunk->capacity - chunk->used;
+    }
+
+    for (Chunk *chunk = _large; chunk; chunk = chunk->next) {
+      _retiredUsed += chunk->used;
+    }
   }
+#endif
 
   kiwi::String kiwi::MemoryPool::string(const char *text, uint32_t count) {
-    char *c_str = allocate<char>(count + 1);
+    char *c_str = allocateUninitialized<char>(count + 1);
     memcpy(c_str, text, count);
-    return String(c_str);
+    c_str[count] = '\0';
+    return String(c_str, count);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+
+  const kiwi::Value *kiwi::Value::find(const String &name) const {
+    uint32_t low = 0;
+    uint32_t high = _kind == OBJECT ? _size : 0;
+
+    // Members are sorted by name
+    while (low < high) {
+      uint32_t middle = low + (high - low) / 2;
+      const String &key = _members[middle].name;
+      if (key == name) return &_members[middle].value;
+      if (key < name) low = middle + 1;
+      else high = middle;
+    }
+
+    return nullptr;
   }
 
   ////////////////////////////////////////////////////////////////////////////////
@@ -466,6 +1932,7 @@ namespace kiwi {
     uint32_t definitionCount = 0;
 
     _definitions = {};
+    _definitionTable = {};
     _pool.clear();
 
     if (!bb.readVarUint(definitionCount)) {
@@ -498,15 +1965,48 @@ namespace kiwi {
       }
     }
 
+    for (auto &definition : _definitions) {
+      definition.hash = _hashDefinition(definition);
+
+      if (definition.kind == KIND_STRUCT) {
+        _compileSkipPlan(definition, 0);
+      } else {
+        _indexFields(definition);
+      }
+
+      if (definition.kind != KIND_ENUM) {
+        _sortFields(definition);
+      }
+    }
+
+    // Index the definitions by name with a table that's at most half full. If
+    // a name is repeated, the first definition with that name wins.
+    uint32_t tableSize = 1;
+    while (tableSize < definitionCount * 2) tableSize *= 2;
+    _definitionTable = _pool.array<uint32_t>(tableSize);
+
+    for (uint32_t i = 0; i < definitionCount; i++) {
+      uint32_t dummy = 0;
+      if (!findDefinition(_definitions[i].name, dummy)) {
+        uint32_t slot = _hash(_definitions[i].name) & (tableSize - 1);
+        while (_definitionTable[slot]) slot = (slot + 1) & (tableSize - 1);
+        _definitionTable[slot] = i + 1;
+      }
+    }
+
     return true;
   }
 
-  bool kiwi::BinarySchema::findDefinition(const char *definition, uint32_t &index) const {
-    for (uint32_t i = 0; i < _definitions.size(); i++) {
-      auto &item = _definitions[i];
-      if (item.name == String(definition)) {
-        index = i;
-        return true;
+  bool kiwi::BinarySchema::findDefinition(const String &definition, uint32_t &index) const {
+    uint32_t mask = _definitionTable.size() - 1;
+
+    if (_definitionTable.size()) {
+      for (uint32_t slot = _hash(definition) & mask; _definitionTable[slot]; slot = (slot + 1) & mask) {
+        uint32_t i = _definitionTable[slot] - 1;
+        if (_definitions[i].name == definition) {
+          index = i;
+          return true;
+        }
       }
     }
 
@@ -515,100 +2015,469 @@ namespace kiwi {
     return false;
   }
 
+  bool kiwi::BinarySchema::definitionHash(uint32_t definition, uint32_t &hash) const {
+    if (definition >= _definitions.size()) {
+      return false;
+    }
+
+    hash = _definitions[definition].hash;
+    return true;
+  }
+
+  // Strings are hashed with their null terminator and numbers as 4 bytes in
+  // little-endian order. This must stay in sync with the code generator.
+  uint32_t kiwi::BinarySchema::_hashDefinition(const Definition &definition) const {
+    static const char *const typeNames[] = {"bool", "byte", "int", "uint", "float", "string", "int64", "uint64"};
+
+    uint32_t hash = _hashBytes(FNV_OFFSET_BASIS, definition.name.c_str(), definition.name.size() + 1);
+    hash = _hashUint32(hash, definition.kind);
+    hash = _hashUint32(hash, definition.fields.size());
+
+    for (auto &field : definition.fields) {
+      // Enum values don't have a type
+      const char *type = definition.kind == KIND_ENUM ? "" :
+        field.type < 0 ? typeNames[~field.type] : _definitions[field.type].name.c_str();
+      hash = _hashBytes(hash, field.name.c_str(), field.name.size() + 1);
+      hash = _hashBytes(hash, type, strlen(type) + 1);
+      hash = _hashUint32(hash, field.isArray);
+      hash = _hashUint32(hash, field.value);
+    }
+
+    return hash;
+  }
+
+  // FNV-1a
+  uint32_t kiwi::BinarySchema::_hashBytes(uint32_t hash, const void *data, size_t size) {
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; i++) {
+      hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+    return hash;
+  }
+
+  uint32_t kiwi::BinarySchema::_hashUint32(uint32_t hash, uint32_t value) {
+    uint8_t bytes[] = {(uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24)};
+    return _hashBytes(hash, bytes, 4);
+  }
+
   bool kiwi::BinarySchema::skipField(ByteBuffer &bb, uint32_t definition, uint32_t field) const {
     if (definition < _definitions.size()) {
-      for (auto &item : _definitions[definition].fields) {
-        if (item.value == field) {
-          return _skipField(bb, item);
-        }
+      if (const Field *item = _findField(_definitions[definition], field)) {
+        return _skipField(bb, *item);
       }
     }
 
     return false;
   }
 
-  bool kiwi::BinarySchema::_skipField(ByteBuffer &bb, const Field &field) const {
-    uint32_t count = 1;
+  void kiwi::BinarySchema::_indexFields(Definition &definition) {
+    uint32_t count = definition.fields.size();
+    uint32_t maxId = 0;
+    for (auto &field : definition.fields) {
+      if (field.value > maxId) maxId = field.value;
+    }
+
+    // Field ids are usually numbered from 1, so index them directly unless
+    // that would waste a lot of space
+    if (maxId < count * 2 + 16) {
+      definition.isDense = true;
+      definition.fieldTable = _pool.array<uint32_t>(maxId + 1);
+      for (uint32_t i = count; i-- > 0;) {
+        definition.fieldTable[definition.fields[i].value] = i + 1;
+      }
+      return;
+    }
+
+    // Otherwise use an open addressing table that's at most half full
+    uint32_t tableSize = 1;
+    while (tableSize < count * 2) tableSize *= 2;
+    definition.fieldTable = _pool.array<uint32_t>(tableSize);
+
+    for (uint32_t i = 0; i < count; i++) {
+      if (!_findField(definition, definition.fields[i].value)) {
+        uint32_t slot = (definition.fields[i].value * 2654435761u) & (tableSize - 1);
+        while (definition.fieldTable[slot]) slot = (slot + 1) & (tableSize - 1);
+        definition.fieldTable[slot] = i + 1;
+      }
+    }
+  }
+
+  const kiwi::BinarySchema::Field *kiwi::BinarySchema::_findField(const Definition &definition, uint32_t id) const {
+    const Array<uint32_t> &table = definition.fieldTable;
+
+    if (definition.isDense) {
+      return id < table.size() && table[id] ? &definition.fields[table[id] - 1] : nullptr;
+    }
+
+    uint32_t mask = table.size() - 1;
+    if (table.size()) {
+      for (uint32_t slot = (id * 2654435761u) & mask; table[slot]; slot = (slot + 1) & mask) {
+        const Field &field = definition.fields[table[slot] - 1];
+        if (field.value == id) return &field;
+      }
+    }
+
+    return nullptr;
+  }
+
+  bool kiwi::BinarySchema::_skipField(ByteBuffer &bb, const Field &root) const {
+    // The stack starts out here and only moves to a pool if it gets deep, so
+    // most skips never create one
+    SkipFrame inlineFrames[INLINE_SKIP_FRAMES];
+    SkipFrame *frames = inlineFrames;
+    uint32_t capacity = INLINE_SKIP_FRAMES;
+    uint32_t depth = 0;
+    std::unique_ptr<MemoryPool> pool;
+
+    // Skips over simple values right away, and pushes a frame for the rest
+    auto begin = [&](const Field &field) -> bool {
+      uint32_t count = 1;
+
+      if (field.isArray && !bb.readVarUint(count)) {
+        return false;
+      }
+
+      uint8_t kind = _skipKind(field.type);
+      if (kind != SKIP_FIELD) {
+        return _skipValues(bb, kind, count);
+      }
+
+      assert(field.type >= 0 && (uint32_t)field.type < _definitions.size());
+      auto &definition = _definitions[field.type];
+
+      if (definition.kind == KIND_STRUCT) {
+        auto &plan = definition.skipPlan;
+
+        // Optimization: arrays of structs with a single step (e.g. only bytes
+        // or only varints) are skipped all at once
+        if (plan.size() == 1 && plan[0].kind != SKIP_FIELD) {
+          return _skipValues(bb, plan[0].kind, (uint64_t)plan[0].count * count);
+        }
+
+        if (plan.size() == 0) {
+          return true;
+        }
+      }
+
+      if (count == 0) {
+        return true;
+      }
+
+      if (depth == _maxDepth) {
+        return false;
+      }
+
+      if (depth == capacity) {
+        if (!pool) pool.reset(new MemoryPool);
+        SkipFrame *larger = pool->allocateUninitialized<SkipFrame>(capacity * 2);
+        memcpy(larger, frames, depth * sizeof(SkipFrame));
+        frames = larger;
+        capacity *= 2;
+      }
+
+      frames[depth++] = {&field, count, 0};
+      return true;
+    };
 
-    if (field.isArray && !bb.readVarUint(count)) {
+    if (!begin(root)) {
       return false;
     }
 
-    while (count-- > 0) {
-      switch (field.type) {
-        case TYPE_BOOL:
-        case TYPE_BYTE: {
-          uint8_t dummy = 0;
-          if (!bb.readByte(dummy)) return false;
-          break;
+    while (depth > 0) {
+      SkipFrame &frame = frames[depth - 1];
+      auto &definition = _definitions[frame.field->type];
+
+      if (definition.kind == KIND_STRUCT) {
+        auto &plan = definition.skipPlan;
+
+        if (frame.step == plan.size()) {
+          frame.step = 0;
+          if (--frame.remaining == 0) depth--;
+          continue;
         }
 
-        case TYPE_INT:
-        case TYPE_UINT: {
-          uint32_t dummy = 0;
-          if (!bb.readVarUint(dummy)) return false;
-          break;
+        auto &step = plan[frame.step++];
+        if (step.kind == SKIP_FIELD ? !begin(*step.field) : !_skipValues(bb, step.kind, step.count)) {
+          return false;
         }
+      }
 
-        case TYPE_FLOAT: {
-          float dummy = 0;
-          if (!bb.readVarFloat(dummy)) return false;
-          break;
+      else {
+        assert(definition.kind == KIND_MESSAGE);
+        uint32_t id = 0;
+
+        if (!bb.readVarUint(id)) {
+          return false;
         }
 
-        case TYPE_STRING: {
-          uint8_t value = 0;
-          do {
-            if (!bb.readByte(value)) return false;
-          } while (value);
-          break;
+        if (!id) {
+          if (--frame.remaining == 0) depth--;
+          continue;
         }
 
-        case TYPE_INT64:
-        case TYPE_UINT64: {
-          uint64_t dummy = 0;
+        const Field *field = _findField(definition, id);
+        if (!field || !begin(*field)) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  bool kiwi::BinarySchema::decode(ByteBuffer &bb, uint32_t definition, Value &result, MemoryPool &pool) const {
+    return definition < _definitions.size() && _definitions[definition].kind != KIND_ENUM &&
+      _decodeValue(bb, definition, result, pool, 0);
+  }
+
+  bool kiwi::BinarySchema::_decodeField(ByteBuffer &bb, const Field &field, Value &result, MemoryPool &pool, uint32_t depth) const {
+    if (!field.isArray) {
+      return _decodeValue(bb, field.type, result, pool, depth);
+    }
+
+    uint32_t count = 0;
+    if (!bb.readVarUint(count)) {
+      return false;
+    }
+
+    // Values that take up no input at all (e.g. empty structs) can't be
+    // limited by the size of the input, so only allow a few of them. Decode
+    // the first element before allocating anything to find out.
+    Value first;
+    size_t start = bb.index();
+    if (count > 0 && !_decodeValue(bb, field.type, first, pool, depth)) {
+      return false;
+    }
+    if (count > MAX_ZERO_WIDTH_ELEMENTS && bb.index() == start) {
+      return false;
+    }
+
+    // Don't trust the count from the input for how much to allocate up front.
+    // Other values take at least a byte, so grow the array if there are more.
+    uint32_t capacity = bb.size() - bb.index() < count ? bb.size() - bb.index() + 16 : count;
+    Value *elements = pool.allocate<Value>(capacity);
+    if (count > 0) elements[0] = first;
+
+    for (uint32_t i = 1; i < count; i++) {
+      if (i == capacity) {
+        capacity = capacity * 2 < count ? capacity * 2 : count;
+        Value *larger = pool.allocate<Value>(capacity);
+        memcpy(larger, elements, i * sizeof(Value));
+        elements = larger;
+      }
+
+      if (!_decodeValue(bb, field.type, elements[i], pool, depth)) {
+        return false;
+      }
+    }
+
+    result._kind = Value::ARRAY;
+    result._size = count;
+    result._elements = elements;
+    return true;
+  }
+
+  bool kiwi::BinarySchema::_decodeValue(ByteBuffer &bb, int32_t type, Value &result, MemoryPool &pool, uint32_t depth) const {
+    switch (type) {
+      case TYPE_BOOL: result._kind = Value::BOOL; return bb.readByte(result._bool);
+      case TYPE_BYTE: result._kind = Value::BYTE; return bb.readByte(result._byte);
+      case TYPE_INT: result._kind = Value::INT; return bb.readVarInt(result._int);
+      case TYPE_UINT: result._kind = Value::UINT; return bb.readVarUint(result._uint);
+      case TYPE_FLOAT: result._kind = Value::FLOAT; return bb.readVarFloat(result._float);
+      case TYPE_INT64: result._kind = Value::INT64; return bb.readVarInt64(result._int64);
+      case TYPE_UINT64: result._kind = Value::UINT64; return bb.readVarUint64(result._uint64);
+
+      case TYPE_STRING: {
+        String value;
+        if (!bb.readString(value, pool)) return false;
+        result._kind = Value::STRING;
+        result._size = value.size();
+        result._string = value.c_str();
+        return true;
+      }
+    }
+
+    assert(type >= 0 && (uint32_t)type < _definitions.size());
+    auto &definition = _definitions[type];
+    result._type = &definition.name;
+
+    if (definition.kind == KIND_ENUM) {
+      uint32_t value = 0;
+      const Field *field = nullptr;
+      if (!bb.readVarUint(value) || !(field = _findField(definition, value))) return false;
+      result._kind = Value::ENUM;
+      result._enumName = &field->name;
+      return true;
+    }
+
+    if (depth == _maxDepth || depth == MAX_DECODE_DEPTH) {
+      return false;
+    }
+
+    // Members are decoded straight into their sorted position. Messages leave
+    // gaps for missing fields, which are removed afterwards.
+    auto &fields = definition.fields;
+    Value::Member *members = pool.allocate<Value::Member>(fields.size());
+    uint32_t count = fields.size();
+
+    if (definition.kind == KIND_STRUCT) {
+      for (uint32_t i = 0; i < fields.size(); i++) {
+        Value::Member &member = members[definition.namePositions[i]];
+        member.name = fields[i].name;
+        if (!_decodeField(bb, fields[i], member.value, pool, depth + 1)) return false;
+      }
+    }
+
+    else {
+      while (true) {
+        uint32_t id = 0;
+        const Field *field = nullptr;
+        if (!bb.readVarUint(id)) return false;
+        if (!id) break;
+        if (!(field = _findField(definition, id))) return false;
+        Value::Member &member = members[definition.namePositions[field - fields.data()]];
+        member.name = field->name;
+        if (!_decodeField(bb, *field, member.value, pool, depth + 1)) return false;
+      }
+
+      count = 0;
+      for (uint32_t i = 0; i < fields.size(); i++) {
+        if (members[i].name.c_str()) members[count++] = members[i];
+      }
+    }
+
+    result._kind = Value::OBJECT;
+    result._size = count;
+    result._members = members;
+    return true;
+  }
+
+  void kiwi::BinarySchema::_sortFields(Definition &definition) {
+    uint32_t count = definition.fields.size();
+    const Field **sorted = _pool.allocateUninitialized<const Field *>(count);
+
+    for (uint32_t i = 0; i < count; i++) {
+      sorted[i] = &definition.fields[i];
+    }
+
+    qsort(sorted, count, sizeof(const Field *), [](const void *a, const void *b) {
+      const String &x = (*static_cast<const Field *const *>(a))->name;
+      const String &y = (*static_cast<const Field *const *>(b))->name;
+      return x < y ? -1 : y < x ? 1 : 0;
+    });
+
+    definition.namePositions = _pool.arrayUninitialized<uint32_t>(count);
+    for (uint32_t i = 0; i < count; i++) {
+      definition.namePositions[sorted[i] - definition.fields.data()] = i;
+    }
+  }
+
+  bool kiwi::BinarySchema::_skipValues(ByteBuffer &bb, uint8_t kind, uint64_t count) const {
+    switch (kind) {
+      case SKIP_BYTES: {
+        return bb.skipBytes(count);
+      }
+
+      case SKIP_VARUINTS: {
+        return bb.skipVarUints(count);
+      }
+
+      case SKIP_VARUINT64S: {
+        for (uint64_t dummy; count > 0; count--) {
           if (!bb.readVarUint64(dummy)) return false;
-          break;
         }
+        return true;
+      }
 
-        default: {
-          assert(field.type >= 0 && (uint32_t)field.type < _definitions.size());
-          auto &definition = _definitions[field.type];
-
-          switch (definition.kind) {
-            case KIND_ENUM: {
-              uint32_t dummy;
-              if (!bb.readVarUint(dummy)) return false;
-              break;
-            }
-
-            case KIND_STRUCT: {
-              for (auto &item : definition.fields) {
-                if (!_skipField(bb, item)) return false;
-              }
-              break;
-            }
-
-            case KIND_MESSAGE: {
-              uint32_t id = 0;
-              while (true) {
-                if (!bb.readVarUint(id)) return false;
-                if (!id) break;
-                if (!skipField(bb, field.type, id)) return false;
-              }
-              break;
-            }
-
-            default: {
-              assert(false);
-              break;
-            }
+      case SKIP_FLOATS: {
+        for (float dummy; count > 0; count--) {
+          if (!bb.readVarFloat(dummy)) return false;
+        }
+        return true;
+      }
+
+      case SKIP_STRINGS: {
+        for (const char *dummy; count > 0; count--) {
+          if (!bb.readString(dummy)) return false;
+        }
+        return true;
+      }
+    }
+
+    assert(false);
+    return false;
+  }
+
+  uint8_t kiwi::BinarySchema::_skipKind(int32_t type) const {
+    switch (type) {
+      case TYPE_BOOL: case TYPE_BYTE: return SKIP_BYTES;
+      case TYPE_INT: case TYPE_UINT: return SKIP_VARUINTS;
+      case TYPE_FLOAT: return SKIP_FLOATS;
+      case TYPE_STRING: return SKIP_STRINGS;
+      case TYPE_INT64: case TYPE_UINT64: return SKIP_VARUINT64S;
+    }
+
+    assert(type >= 0 && (uint32_t)type < _definitions.size());
+    return _definitions[type].kind == KIND_ENUM ? SKIP_VARUINTS : SKIP_FIELD;
+  }
+
+  void kiwi::BinarySchema::_compileSkipPlan(Definition &definition, uint32_t depth) {
+    if (definition.planState != PLAN_NONE) {
+      return;
+    }
+
+    // Compile nested structs first so their steps can be inlined. Recursive
+    // structs and very deep nesting are skipped through SKIP_FIELD instead.
+    definition.planState = PLAN_COMPILING;
+    if (depth < MAX_PLAN_DEPTH) {
+      for (auto &field : definition.fields) {
+        if (field.type >= 0 && !field.isArray && _definitions[field.type].kind == KIND_STRUCT) {
+          _compileSkipPlan(_definitions[field.type], depth + 1);
+        }
+      }
+    }
+
+    // Count the steps first, then fill them in
+    definition.skipPlan = _pool.array<SkipStep>(_emitSkipPlan(definition, nullptr));
+    _emitSkipPlan(definition, definition.skipPlan.data());
+    definition.planState = PLAN_DONE;
+  }
+
+  uint32_t kiwi::BinarySchema::_emitSkipPlan(const Definition &definition, SkipStep *steps) const {
+    uint32_t count = 0;
+    uint8_t lastKind = SKIP_FIELD;
+
+    auto emit = [&](uint8_t kind, uint32_t stepCount, const Field *field) {
+      if (kind != SKIP_FIELD && kind == lastKind) {
+        if (steps) steps[count - 1].count += stepCount;
+        return;
+      }
+      if (steps) {
+        steps[count].kind = kind;
+        steps[count].count = stepCount;
+        steps[count].field = field;
+      }
+      lastKind = kind;
+      count++;
+    };
+
+    for (auto &field : definition.fields) {
+      uint8_t kind = field.isArray ? (uint8_t)SKIP_FIELD : _skipKind(field.type);
+
+      if (kind == SKIP_FIELD && !field.isArray && _definitions[field.type].kind == KIND_STRUCT) {
+        auto &nested = _definitions[field.type];
+        if (nested.planState == PLAN_DONE && nested.skipPlan.size() <= MAX_INLINED_STEPS) {
+          for (auto &step : nested.skipPlan) {
+            emit(step.kind, step.count, step.field);
           }
+          continue;
         }
       }
+
+      emit(kind, 1, kind == SKIP_FIELD ? &field : nullptr);
     }
 
-    return true;
+    return count;
   }
 
 #endif
@@ -3,6 +3,7 @@
 
 #include "test-schema-callback.h"
 #include <stdio.h>
+#include <string>
 
 void testRoundTripDeprecatedMessage() {
   puts("testRoundTripDeprecatedMessage");
@@ -95,9 +96,52 @@ void testRoundTripSortedStruct() {
   assert(!memcmp(bb.data(), bb2.data(), bb.size()));
 }
 
+void testRoundTripStreaming() {
+  puts("testRoundTripStreaming");
+
+  kiwi::ByteBuffer bb;
+  test::Writer writer(bb);
+
+  writer.visitStringPairStruct("first string", "second", 300);
+  writer.beginStringPairArrayStruct();
+  writer.visitStringPairArrayStruct_x_count(20);
+  for (uint32_t i = 0; i < 20; i++) {
+    std::string a(i, 'a' + i);
+    std::string b(20 - i, 'A' + i);
+    writer.visitStringPairArrayStruct_x_element(a.c_str(), b.c_str(), i * 1000);
+  }
+  writer.endStringPairArrayStruct();
+
+  // Deliver the input in small blocks so every value crosses a refill
+  struct Input {
+    const kiwi::ByteBuffer *bb;
+    size_t index;
+  };
+  Input input{&bb, 0};
+  kiwi::ByteBuffer stream;
+  stream.setSource([](void *context, uint8_t *data, size_t size) -> size_t {
+    Input &input = *static_cast<Input *>(context);
+    size_t count = input.bb->size() - input.index;
+    if (count > size) count = size;
+    memcpy(data, input.bb->data() + input.index, count);
+    input.index += count;
+    return count;
+  }, &input, 8);
+
+  kiwi::ByteBuffer bb2;
+  test::Writer writer2(bb2);
+
+  assert(test::parseStringPairStruct(stream, writer2));
+  assert(test::parseStringPairArrayStruct(stream, writer2));
+  assert(stream.index() == bb.size());
+  assert(bb.size() == bb2.size());
+  assert(!memcmp(bb.data(), bb2.data(), bb.size()));
+}
+
 int main() {
   testRoundTripDeprecatedMessage();
   testRoundTripSortedStruct();
+  testRoundTripStreaming();
 
   puts("all tests passed");
   return 0;
@@ -191,6 +191,11 @@ public:
   virtual void visitSortedStruct_h3_count(uint32_t size) = 0;
   virtual void visitSortedStruct_h3_element(uint64_t h3) = 0;
   virtual void endSortedStruct() = 0;
+  virtual void visitStringPairStruct(const char *a, const char *b, uint32_t c) = 0;
+  virtual void beginStringPairArrayStruct() = 0;
+  virtual void visitStringPairArrayStruct_x_count(uint32_t size) = 0;
+  virtual void visitStringPairArrayStruct_x_element(const char *x_a, const char *x_b, uint32_t x_c) = 0;
+  virtual void endStringPairArrayStruct() = 0;
 };
 
 class Writer : public Visitor {
@@ -377,6 +382,11 @@ public:
   virtual void visitSortedStruct_h3_count(uint32_t size) override;
   virtual void visitSortedStruct_h3_element(uint64_t h3) override;
   virtual void endSortedStruct() override;
+  virtual void visitStringPairStruct(const char *a, const char *b, uint32_t c) override;
+  virtual void beginStringPairArrayStruct() override;
+  virtual void visitStringPairArrayStruct_x_count(uint32_t size) override;
+  virtual void visitStringPairArrayStruct_x_element(const char *x_a, const char *x_b, uint32_t x_c) override;
+  virtual void endStringPairArrayStruct() override;
 };
 
 bool parseEnumStruct(kiwi::ByteBuffer &bb, Visitor &visitor);
@@ -422,6 +432,8 @@ bool parseRecursiveMessage(kiwi::ByteBuffer &bb, Visitor &visitor);
 bool parseNonDeprecatedMessage(kiwi::ByteBuffer &bb, Visitor &visitor);
 bool parseDeprecatedMessage(kiwi::ByteBuffer &bb, Visitor &visitor);
 bool parseSortedStruct(kiwi::ByteBuffer &bb, Visitor &visitor);
+bool parseStringPairStruct(kiwi::ByteBuffer &bb, Visitor &visitor);
+bool parseStringPairArrayStruct(kiwi::ByteBuffer &bb, Visitor &visitor);
 
 #ifdef IMPLEMENT_SCHEMA_H
 
@@ -1390,6 +1402,43 @@ bool parseSortedStruct(kiwi::ByteBuffer &bb, Visitor &visitor) {
   return true;
 }
 
+bool parseStringPairStruct(kiwi::ByteBuffer &bb, Visitor &visitor) {
+  const char *a;
+  const char *b;
+  uint32_t c;
+  size_t _start = bb.pin();
+  bool _failed = !bb.readString(a) || !bb.readString(b) || !bb.readVarUint(c);
+  if (bb.unpin() && !_failed) {
+    bb.seek(_start);
+    _failed = !bb.readString(a) || !bb.readString(b) || !bb.readVarUint(c);
+  }
+  if (_failed) return false;
+  visitor.visitStringPairStruct(a, b, c);
+  return true;
+}
+
+bool parseStringPairArrayStruct(kiwi::ByteBuffer &bb, Visitor &visitor) {
+  visitor.beginStringPairArrayStruct();
+  uint32_t _x_count;
+  if (!bb.readVarUint(_x_count)) return false;
+  visitor.visitStringPairArrayStruct_x_count(_x_count);
+  while (_x_count-- > 0) {
+    const char *x_a;
+    const char *x_b;
+    uint32_t x_c;
+    size_t _x_element_start = bb.pin();
+    bool _x_element_failed = !bb.readString(x_a) || !bb.readString(x_b) || !bb.readVarUint(x_c);
+    if (bb.unpin() && !_x_element_failed) {
+      bb.seek(_x_element_start);
+      _x_element_failed = !bb.readString(x_a) || !bb.readString(x_b) || !bb.readVarUint(x_c);
+    }
+    if (_x_element_failed) return false;
+    visitor.visitStringPairArrayStruct_x_element(x_a, x_b, x_c);
+  }
+  visitor.endStringPairArrayStruct();
+  return true;
+}
+
 void Writer::beginEnumStruct() {
 }
 
@@ -2099,6 +2148,28 @@ void Writer::visitSortedStruct_h3_element(uint64_t h3) {
 void Writer::endSortedStruct() {
 }
 
+void Writer::visitStringPairStruct(const char *a, const char *b, uint32_t c) {
+  _bb.writeString(a);
+  _bb.writeString(b);
+  _bb.writeVarUint(c);
+}
+
+void Writer::beginStringPairArrayStruct() {
+}
+
+void Writer::visitStringPairArrayStruct_x_count(uint32_t size) {
+  _bb.writeVarUint(size);
+}
+
+void Writer::visitStringPairArrayStruct_x_element(const char *x_a, const char *x_b, uint32_t x_c) {
+  _bb.writeString(x_a);
+  _bb.writeString(x_b);
+  _bb.writeVarUint(x_c);
+}
+
+void Writer::endStringPairArrayStruct() {
+}
+
 #endif
 
 }
@@ -9,10 +9,17 @@ class BinarySchema {
 public:
   bool parse(kiwi::ByteBuffer &bb);
   const kiwi::BinarySchema &underlyingSchema() const { return _schema; }
+
+  // Whether all or one of the definitions compiled in here are exactly the same in the parsed schema
+  bool isIdentical() const { return _isIdentical; }
+  bool isIdentical(const char *definition) const;
+
   bool skipMessageField(kiwi::ByteBuffer &bb, uint32_t id) const;
 
 private:
   kiwi::BinarySchema _schema;
+  bool _isIdentical = false;
+  bool _identical[2] = {};
   uint32_t _indexMessage = 0;
 };
 
@@ -544,7 +551,9 @@ public:
   void set_f129(const int32_t &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[5] = {};
@@ -1205,7 +1214,9 @@ public:
   void set_f129(const int32_t &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[5] = {};
@@ -1344,12 +1355,31 @@ private:
 #endif
 #ifdef IMPLEMENT_SCHEMA_H
 
+static const struct { const char *name; uint32_t hash; } _definitionHashes[] = {
+  {"Struct", 1421406469u},
+  {"Message", 1804838706u},
+};
+
 bool BinarySchema::parse(kiwi::ByteBuffer &bb) {
   if (!_schema.parse(bb)) return false;
   _schema.findDefinition("Message", _indexMessage);
+  _isIdentical = true;
+  for (uint32_t i = 0; i < 2; i++) {
+    uint32_t index, hash;
+    _identical[i] = _schema.findDefinition(_definitionHashes[i].name, index) &&
+      _schema.definitionHash(index, hash) && hash == _definitionHashes[i].hash;
+    _isIdentical = _isIdentical && _identical[i];
+  }
   return true;
 }
 
+bool BinarySchema::isIdentical(const char *definition) const {
+  for (uint32_t i = 0; i < 2; i++) {
+    if (!strcmp(_definitionHashes[i].name, definition)) return _identical[i];
+  }
+  return false;
+}
+
 bool BinarySchema::skipMessageField(kiwi::ByteBuffer &bb, uint32_t id) const {
   return _schema.skipField(bb, _indexMessage, id);
 }
@@ -2916,384 +2946,914 @@ void Struct::set_f129(const int32_t &value) {
 
 bool Struct::encode(kiwi::ByteBuffer &_bb) {
   if (f0() == nullptr) return false;
-  _bb.writeVarInt(_data_f0);
   if (f1() == nullptr) return false;
-  _bb.writeVarInt(_data_f1);
   if (f2() == nullptr) return false;
-  _bb.writeVarInt(_data_f2);
   if (f3() == nullptr) return false;
-  _bb.writeVarInt(_data_f3);
   if (f4() == nullptr) return false;
-  _bb.writeVarInt(_data_f4);
   if (f5() == nullptr) return false;
-  _bb.writeVarInt(_data_f5);
   if (f6() == nullptr) return false;
-  _bb.writeVarInt(_data_f6);
   if (f7() == nullptr) return false;
-  _bb.writeVarInt(_data_f7);
   if (f8() == nullptr) return false;
-  _bb.writeVarInt(_data_f8);
   if (f9() == nullptr) return false;
-  _bb.writeVarInt(_data_f9);
   if (f10() == nullptr) return false;
-  _bb.writeVarInt(_data_f10);
   if (f11() == nullptr) return false;
-  _bb.writeVarInt(_data_f11);
   if (f12() == nullptr) return false;
-  _bb.writeVarInt(_data_f12);
   if (f13() == nullptr) return false;
-  _bb.writeVarInt(_data_f13);
   if (f14() == nullptr) return false;
-  _bb.writeVarInt(_data_f14);
   if (f15() == nullptr) return false;
-  _bb.writeVarInt(_data_f15);
   if (f16() == nullptr) return false;
-  _bb.writeVarInt(_data_f16);
   if (f17() == nullptr) return false;
-  _bb.writeVarInt(_data_f17);
   if (f18() == nullptr) return false;
-  _bb.writeVarInt(_data_f18);
   if (f19() == nullptr) return false;
-  _bb.writeVarInt(_data_f19);
   if (f20() == nullptr) return false;
-  _bb.writeVarInt(_data_f20);
   if (f21() == nullptr) return false;
-  _bb.writeVarInt(_data_f21);
   if (f22() == nullptr) return false;
-  _bb.writeVarInt(_data_f22);
   if (f23() == nullptr) return false;
-  _bb.writeVarInt(_data_f23);
   if (f24() == nullptr) return false;
-  _bb.writeVarInt(_data_f24);
   if (f25() == nullptr) return false;
-  _bb.writeVarInt(_data_f25);
   if (f26() == nullptr) return false;
-  _bb.writeVarInt(_data_f26);
   if (f27() == nullptr) return false;
-  _bb.writeVarInt(_data_f27);
   if (f28() == nullptr) return false;
-  _bb.writeVarInt(_data_f28);
   if (f29() == nullptr) return false;
-  _bb.writeVarInt(_data_f29);
   if (f30() == nullptr) return false;
-  _bb.writeVarInt(_data_f30);
   if (f31() == nullptr) return false;
-  _bb.writeVarInt(_data_f31);
   if (f32() == nullptr) return false;
-  _bb.writeVarInt(_data_f32);
   if (f33() == nullptr) return false;
-  _bb.writeVarInt(_data_f33);
   if (f34() == nullptr) return false;
-  _bb.writeVarInt(_data_f34);
   if (f35() == nullptr) return false;
-  _bb.writeVarInt(_data_f35);
   if (f36() == nullptr) return false;
-  _bb.writeVarInt(_data_f36);
   if (f37() == nullptr) return false;
-  _bb.writeVarInt(_data_f37);
   if (f38() == nullptr) return false;
-  _bb.writeVarInt(_data_f38);
   if (f39() == nullptr) return false;
-  _bb.writeVarInt(_data_f39);
   if (f40() == nullptr) return false;
-  _bb.writeVarInt(_data_f40);
   if (f41() == nullptr) return false;
-  _bb.writeVarInt(_data_f41);
   if (f42() == nullptr) return false;
-  _bb.writeVarInt(_data_f42);
   if (f43() == nullptr) return false;
-  _bb.writeVarInt(_data_f43);
   if (f44() == nullptr) return false;
-  _bb.writeVarInt(_data_f44);
   if (f45() == nullptr) return false;
-  _bb.writeVarInt(_data_f45);
   if (f46() == nullptr) return false;
-  _bb.writeVarInt(_data_f46);
   if (f47() == nullptr) return false;
-  _bb.writeVarInt(_data_f47);
   if (f48() == nullptr) return false;
-  _bb.writeVarInt(_data_f48);
   if (f49() == nullptr) return false;
-  _bb.writeVarInt(_data_f49);
   if (f50() == nullptr) return false;
-  _bb.writeVarInt(_data_f50);
   if (f51() == nullptr) return false;
-  _bb.writeVarInt(_data_f51);
   if (f52() == nullptr) return false;
-  _bb.writeVarInt(_data_f52);
   if (f53() == nullptr) return false;
-  _bb.writeVarInt(_data_f53);
   if (f54() == nullptr) return false;
-  _bb.writeVarInt(_data_f54);
   if (f55() == nullptr) return false;
-  _bb.writeVarInt(_data_f55);
   if (f56() == nullptr) return false;
-  _bb.writeVarInt(_data_f56);
   if (f57() == nullptr) return false;
-  _bb.writeVarInt(_data_f57);
   if (f58() == nullptr) return false;
-  _bb.writeVarInt(_data_f58);
   if (f59() == nullptr) return false;
-  _bb.writeVarInt(_data_f59);
   if (f60() == nullptr) return false;
-  _bb.writeVarInt(_data_f60);
   if (f61() == nullptr) return false;
-  _bb.writeVarInt(_data_f61);
   if (f62() == nullptr) return false;
-  _bb.writeVarInt(_data_f62);
   if (f63() == nullptr) return false;
-  _bb.writeVarInt(_data_f63);
   if (f64() == nullptr) return false;
-  _bb.writeVarInt(_data_f64);
   if (f65() == nullptr) return false;
-  _bb.writeVarInt(_data_f65);
   if (f66() == nullptr) return false;
-  _bb.writeVarInt(_data_f66);
   if (f67() == nullptr) return false;
-  _bb.writeVarInt(_data_f67);
   if (f68() == nullptr) return false;
-  _bb.writeVarInt(_data_f68);
   if (f69() == nullptr) return false;
-  _bb.writeVarInt(_data_f69);
   if (f70() == nullptr) return false;
-  _bb.writeVarInt(_data_f70);
   if (f71() == nullptr) return false;
-  _bb.writeVarInt(_data_f71);
   if (f72() == nullptr) return false;
-  _bb.writeVarInt(_data_f72);
   if (f73() == nullptr) return false;
-  _bb.writeVarInt(_data_f73);
   if (f74() == nullptr) return false;
-  _bb.writeVarInt(_data_f74);
   if (f75() == nullptr) return false;
-  _bb.writeVarInt(_data_f75);
   if (f76() == nullptr) return false;
-  _bb.writeVarInt(_data_f76);
   if (f77() == nullptr) return false;
-  _bb.writeVarInt(_data_f77);
   if (f78() == nullptr) return false;
-  _bb.writeVarInt(_data_f78);
   if (f79() == nullptr) return false;
-  _bb.writeVarInt(_data_f79);
   if (f80() == nullptr) return false;
-  _bb.writeVarInt(_data_f80);
   if (f81() == nullptr) return false;
-  _bb.writeVarInt(_data_f81);
   if (f82() == nullptr) return false;
-  _bb.writeVarInt(_data_f82);
   if (f83() == nullptr) return false;
-  _bb.writeVarInt(_data_f83);
   if (f84() == nullptr) return false;
-  _bb.writeVarInt(_data_f84);
   if (f85() == nullptr) return false;
-  _bb.writeVarInt(_data_f85);
   if (f86() == nullptr) return false;
-  _bb.writeVarInt(_data_f86);
   if (f87() == nullptr) return false;
-  _bb.writeVarInt(_data_f87);
   if (f88() == nullptr) return false;
-  _bb.writeVarInt(_data_f88);
   if (f89() == nullptr) return false;
-  _bb.writeVarInt(_data_f89);
   if (f90() == nullptr) return false;
-  _bb.writeVarInt(_data_f90);
   if (f91() == nullptr) return false;
-  _bb.writeVarInt(_data_f91);
   if (f92() == nullptr) return false;
-  _bb.writeVarInt(_data_f92);
   if (f93() == nullptr) return false;
-  _bb.writeVarInt(_data_f93);
   if (f94() == nullptr) return false;
-  _bb.writeVarInt(_data_f94);
   if (f95() == nullptr) return false;
-  _bb.writeVarInt(_data_f95);
   if (f96() == nullptr) return false;
-  _bb.writeVarInt(_data_f96);
   if (f97() == nullptr) return false;
-  _bb.writeVarInt(_data_f97);
   if (f98() == nullptr) return false;
-  _bb.writeVarInt(_data_f98);
   if (f99() == nullptr) return false;
-  _bb.writeVarInt(_data_f99);
   if (f100() == nullptr) return false;
-  _bb.writeVarInt(_data_f100);
   if (f101() == nullptr) return false;
-  _bb.writeVarInt(_data_f101);
   if (f102() == nullptr) return false;
-  _bb.writeVarInt(_data_f102);
   if (f103() == nullptr) return false;
-  _bb.writeVarInt(_data_f103);
   if (f104() == nullptr) return false;
-  _bb.writeVarInt(_data_f104);
   if (f105() == nullptr) return false;
-  _bb.writeVarInt(_data_f105);
   if (f106() == nullptr) return false;
-  _bb.writeVarInt(_data_f106);
   if (f107() == nullptr) return false;
-  _bb.writeVarInt(_data_f107);
   if (f108() == nullptr) return false;
-  _bb.writeVarInt(_data_f108);
   if (f109() == nullptr) return false;
-  _bb.writeVarInt(_data_f109);
   if (f110() == nullptr) return false;
-  _bb.writeVarInt(_data_f110);
   if (f111() == nullptr) return false;
-  _bb.writeVarInt(_data_f111);
   if (f112() == nullptr) return false;
-  _bb.writeVarInt(_data_f112);
   if (f113() == nullptr) return false;
-  _bb.writeVarInt(_data_f113);
   if (f114() == nullptr) return false;
-  _bb.writeVarInt(_data_f114);
   if (f115() == nullptr) return false;
-  _bb.writeVarInt(_data_f115);
   if (f116() == nullptr) return false;
-  _bb.writeVarInt(_data_f116);
   if (f117() == nullptr) return false;
-  _bb.writeVarInt(_data_f117);
   if (f118() == nullptr) return false;
-  _bb.writeVarInt(_data_f118);
   if (f119() == nullptr) return false;
-  _bb.writeVarInt(_data_f119);
   if (f120() == nullptr) return false;
-  _bb.writeVarInt(_data_f120);
   if (f121() == nullptr) return false;
-  _bb.writeVarInt(_data_f121);
   if (f122() == nullptr) return false;
-  _bb.writeVarInt(_data_f122);
   if (f123() == nullptr) return false;
-  _bb.writeVarInt(_data_f123);
   if (f124() == nullptr) return false;
-  _bb.writeVarInt(_data_f124);
   if (f125() == nullptr) return false;
-  _bb.writeVarInt(_data_f125);
   if (f126() == nullptr) return false;
-  _bb.writeVarInt(_data_f126);
   if (f127() == nullptr) return false;
-  _bb.writeVarInt(_data_f127);
   if (f128() == nullptr) return false;
-  _bb.writeVarInt(_data_f128);
   if (f129() == nullptr) return false;
-  _bb.writeVarInt(_data_f129);
-  return true;
-}
-
-bool Struct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
-  if (!_bb.readVarInt(_data_f0)) return false;
-  set_f0(_data_f0);
-  if (!_bb.readVarInt(_data_f1)) return false;
-  set_f1(_data_f1);
-  if (!_bb.readVarInt(_data_f2)) return false;
-  set_f2(_data_f2);
-  if (!_bb.readVarInt(_data_f3)) return false;
-  set_f3(_data_f3);
-  if (!_bb.readVarInt(_data_f4)) return false;
-  set_f4(_data_f4);
-  if (!_bb.readVarInt(_data_f5)) return false;
-  set_f5(_data_f5);
-  if (!_bb.readVarInt(_data_f6)) return false;
-  set_f6(_data_f6);
-  if (!_bb.readVarInt(_data_f7)) return false;
-  set_f7(_data_f7);
-  if (!_bb.readVarInt(_data_f8)) return false;
-  set_f8(_data_f8);
-  if (!_bb.readVarInt(_data_f9)) return false;
-  set_f9(_data_f9);
-  if (!_bb.readVarInt(_data_f10)) return false;
-  set_f10(_data_f10);
-  if (!_bb.readVarInt(_data_f11)) return false;
-  set_f11(_data_f11);
-  if (!_bb.readVarInt(_data_f12)) return false;
-  set_f12(_data_f12);
-  if (!_bb.readVarInt(_data_f13)) return false;
-  set_f13(_data_f13);
-  if (!_bb.readVarInt(_data_f14)) return false;
-  set_f14(_data_f14);
-  if (!_bb.readVarInt(_data_f15)) return false;
-  set_f15(_data_f15);
-  if (!_bb.readVarInt(_data_f16)) return false;
-  set_f16(_data_f16);
-  if (!_bb.readVarInt(_data_f17)) return false;
-  set_f17(_data_f17);
-  if (!_bb.readVarInt(_data_f18)) return false;
-  set_f18(_data_f18);
-  if (!_bb.readVarInt(_data_f19)) return false;
-  set_f19(_data_f19);
-  if (!_bb.readVarInt(_data_f20)) return false;
-  set_f20(_data_f20);
-  if (!_bb.readVarInt(_data_f21)) return false;
-  set_f21(_data_f21);
-  if (!_bb.readVarInt(_data_f22)) return false;
-  set_f22(_data_f22);
-  if (!_bb.readVarInt(_data_f23)) return false;
-  set_f23(_data_f23);
-  if (!_bb.readVarInt(_data_f24)) return false;
-  set_f24(_data_f24);
-  if (!_bb.readVarInt(_data_f25)) return false;
-  set_f25(_data_f25);
-  if (!_bb.readVarInt(_data_f26)) return false;
-  set_f26(_data_f26);
-  if (!_bb.readVarInt(_data_f27)) return false;
-  set_f27(_data_f27);
-  if (!_bb.readVarInt(_data_f28)) return false;
-  set_f28(_data_f28);
-  if (!_bb.readVarInt(_data_f29)) return false;
-  set_f29(_data_f29);
-  if (!_bb.readVarInt(_data_f30)) return false;
-  set_f30(_data_f30);
-  if (!_bb.readVarInt(_data_f31)) return false;
-  set_f31(_data_f31);
-  if (!_bb.readVarInt(_data_f32)) return false;
-  set_f32(_data_f32);
-  if (!_bb.readVarInt(_data_f33)) return false;
-  set_f33(_data_f33);
-  if (!_bb.readVarInt(_data_f34)) return false;
-  set_f34(_data_f34);
-  if (!_bb.readVarInt(_data_f35)) return false;
-  set_f35(_data_f35);
-  if (!_bb.readVarInt(_data_f36)) return false;
-  set_f36(_data_f36);
-  if (!_bb.readVarInt(_data_f37)) return false;
-  set_f37(_data_f37);
-  if (!_bb.readVarInt(_data_f38)) return false;
-  set_f38(_data_f38);
-  if (!_bb.readVarInt(_data_f39)) return false;
-  set_f39(_data_f39);
-  if (!_bb.readVarInt(_data_f40)) return false;
-  set_f40(_data_f40);
-  if (!_bb.readVarInt(_data_f41)) return false;
-  set_f41(_data_f41);
-  if (!_bb.readVarInt(_data_f42)) return false;
-  set_f42(_data_f42);
-  if (!_bb.readVarInt(_data_f43)) return false;
-  set_f43(_data_f43);
-  if (!_bb.readVarInt(_data_f44)) return false;
-  set_f44(_data_f44);
-  if (!_bb.readVarInt(_data_f45)) return false;
-  set_f45(_data_f45);
-  if (!_bb.readVarInt(_data_f46)) return false;
-  set_f46(_data_f46);
-  if (!_bb.readVarInt(_data_f47)) return false;
-  set_f47(_data_f47);
-  if (!_bb.readVarInt(_data_f48)) return false;
-  set_f48(_data_f48);
-  if (!_bb.readVarInt(_data_f49)) return false;
-  set_f49(_data_f49);
-  if (!_bb.readVarInt(_data_f50)) return false;
-  set_f50(_data_f50);
-  if (!_bb.readVarInt(_data_f51)) return false;
-  set_f51(_data_f51);
-  if (!_bb.readVarInt(_data_f52)) return false;
-  set_f52(_data_f52);
-  if (!_bb.readVarInt(_data_f53)) return false;
-  set_f53(_data_f53);
-  if (!_bb.readVarInt(_data_f54)) return false;
-  set_f54(_data_f54);
-  if (!_bb.readVarInt(_data_f55)) return false;
-  set_f55(_data_f55);
-  if (!_bb.readVarInt(_data_f56)) return false;
-  set_f56(_data_f56);
-  if (!_bb.readVarInt(_data_f57)) return false;
+  if (_bb.writeBatchSize(1, 650)) {
+    uint8_t *_out = _bb.beginWrite(650);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f0);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f1);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f2);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f3);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f4);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f5);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f6);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f7);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f8);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f9);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f10);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f11);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f12);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f13);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f14);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f15);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f16);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f17);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f18);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f19);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f20);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f21);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f22);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f23);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f24);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f25);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f26);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f27);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f28);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f29);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f30);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f31);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f32);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f33);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f34);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f35);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f36);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f37);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f38);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f39);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f40);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f41);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f42);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f43);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f44);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f45);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f46);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f47);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f48);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f49);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f50);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f51);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f52);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f53);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f54);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f55);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f56);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f57);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f58);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f59);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f60);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f61);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f62);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f63);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f64);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f65);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f66);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f67);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f68);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f69);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f70);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f71);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f72);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f73);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f74);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f75);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f76);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f77);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f78);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f79);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f80);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f81);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f82);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f83);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f84);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f85);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f86);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f87);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f88);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f89);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f90);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f91);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f92);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f93);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f94);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f95);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f96);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f97);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f98);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f99);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f100);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f101);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f102);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f103);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f104);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f105);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f106);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f107);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f108);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f109);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f110);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f111);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f112);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f113);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f114);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f115);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f116);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f117);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f118);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f119);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f120);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f121);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f122);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f123);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f124);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f125);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f126);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f127);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f128);
+    kiwi::ByteBuffer::putVarInt(_out, _data_f129);
+    _bb.endWrite(_out);
+    return true;
+  }
+  _bb.writeVarInt(_data_f0);
+  _bb.writeVarInt(_data_f1);
+  _bb.writeVarInt(_data_f2);
+  _bb.writeVarInt(_data_f3);
+  _bb.writeVarInt(_data_f4);
+  _bb.writeVarInt(_data_f5);
+  _bb.writeVarInt(_data_f6);
+  _bb.writeVarInt(_data_f7);
+  _bb.writeVarInt(_data_f8);
+  _bb.writeVarInt(_data_f9);
+  _bb.writeVarInt(_data_f10);
+  _bb.writeVarInt(_data_f11);
+  _bb.writeVarInt(_data_f12);
+  _bb.writeVarInt(_data_f13);
+  _bb.writeVarInt(_data_f14);
+  _bb.writeVarInt(_data_f15);
+  _bb.writeVarInt(_data_f16);
+  _bb.writeVarInt(_data_f17);
+  _bb.writeVarInt(_data_f18);
+  _bb.writeVarInt(_data_f19);
+  _bb.writeVarInt(_data_f20);
+  _bb.writeVarInt(_data_f21);
+  _bb.writeVarInt(_data_f22);
+  _bb.writeVarInt(_data_f23);
+  _bb.writeVarInt(_data_f24);
+  _bb.writeVarInt(_data_f25);
+  _bb.writeVarInt(_data_f26);
+  _bb.writeVarInt(_data_f27);
+  _bb.writeVarInt(_data_f28);
+  _bb.writeVarInt(_data_f29);
+  _bb.writeVarInt(_data_f30);
+  _bb.writeVarInt(_data_f31);
+  _bb.writeVarInt(_data_f32);
+  _bb.writeVarInt(_data_f33);
+  _bb.writeVarInt(_data_f34);
+  _bb.writeVarInt(_data_f35);
+  _bb.writeVarInt(_data_f36);
+  _bb.writeVarInt(_data_f37);
+  _bb.writeVarInt(_data_f38);
+  _bb.writeVarInt(_data_f39);
+  _bb.writeVarInt(_data_f40);
+  _bb.writeVarInt(_data_f41);
+  _bb.writeVarInt(_data_f42);
+  _bb.writeVarInt(_data_f43);
+  _bb.writeVarInt(_data_f44);
+  _bb.writeVarInt(_data_f45);
+  _bb.writeVarInt(_data_f46);
+  _bb.writeVarInt(_data_f47);
+  _bb.writeVarInt(_data_f48);
+  _bb.writeVarInt(_data_f49);
+  _bb.writeVarInt(_data_f50);
+  _bb.writeVarInt(_data_f51);
+  _bb.writeVarInt(_data_f52);
+  _bb.writeVarInt(_data_f53);
+  _bb.writeVarInt(_data_f54);
+  _bb.writeVarInt(_data_f55);
+  _bb.writeVarInt(_data_f56);
+  _bb.writeVarInt(_data_f57);
+  _bb.writeVarInt(_data_f58);
+  _bb.writeVarInt(_data_f59);
+  _bb.writeVarInt(_data_f60);
+  _bb.writeVarInt(_data_f61);
+  _bb.writeVarInt(_data_f62);
+  _bb.writeVarInt(_data_f63);
+  _bb.writeVarInt(_data_f64);
+  _bb.writeVarInt(_data_f65);
+  _bb.writeVarInt(_data_f66);
+  _bb.writeVarInt(_data_f67);
+  _bb.writeVarInt(_data_f68);
+  _bb.writeVarInt(_data_f69);
+  _bb.writeVarInt(_data_f70);
+  _bb.writeVarInt(_data_f71);
+  _bb.writeVarInt(_data_f72);
+  _bb.writeVarInt(_data_f73);
+  _bb.writeVarInt(_data_f74);
+  _bb.writeVarInt(_data_f75);
+  _bb.writeVarInt(_data_f76);
+  _bb.writeVarInt(_data_f77);
+  _bb.writeVarInt(_data_f78);
+  _bb.writeVarInt(_data_f79);
+  _bb.writeVarInt(_data_f80);
+  _bb.writeVarInt(_data_f81);
+  _bb.writeVarInt(_data_f82);
+  _bb.writeVarInt(_data_f83);
+  _bb.writeVarInt(_data_f84);
+  _bb.writeVarInt(_data_f85);
+  _bb.writeVarInt(_data_f86);
+  _bb.writeVarInt(_data_f87);
+  _bb.writeVarInt(_data_f88);
+  _bb.writeVarInt(_data_f89);
+  _bb.writeVarInt(_data_f90);
+  _bb.writeVarInt(_data_f91);
+  _bb.writeVarInt(_data_f92);
+  _bb.writeVarInt(_data_f93);
+  _bb.writeVarInt(_data_f94);
+  _bb.writeVarInt(_data_f95);
+  _bb.writeVarInt(_data_f96);
+  _bb.writeVarInt(_data_f97);
+  _bb.writeVarInt(_data_f98);
+  _bb.writeVarInt(_data_f99);
+  _bb.writeVarInt(_data_f100);
+  _bb.writeVarInt(_data_f101);
+  _bb.writeVarInt(_data_f102);
+  _bb.writeVarInt(_data_f103);
+  _bb.writeVarInt(_data_f104);
+  _bb.writeVarInt(_data_f105);
+  _bb.writeVarInt(_data_f106);
+  _bb.writeVarInt(_data_f107);
+  _bb.writeVarInt(_data_f108);
+  _bb.writeVarInt(_data_f109);
+  _bb.writeVarInt(_data_f110);
+  _bb.writeVarInt(_data_f111);
+  _bb.writeVarInt(_data_f112);
+  _bb.writeVarInt(_data_f113);
+  _bb.writeVarInt(_data_f114);
+  _bb.writeVarInt(_data_f115);
+  _bb.writeVarInt(_data_f116);
+  _bb.writeVarInt(_data_f117);
+  _bb.writeVarInt(_data_f118);
+  _bb.writeVarInt(_data_f119);
+  _bb.writeVarInt(_data_f120);
+  _bb.writeVarInt(_data_f121);
+  _bb.writeVarInt(_data_f122);
+  _bb.writeVarInt(_data_f123);
+  _bb.writeVarInt(_data_f124);
+  _bb.writeVarInt(_data_f125);
+  _bb.writeVarInt(_data_f126);
+  _bb.writeVarInt(_data_f127);
+  _bb.writeVarInt(_data_f128);
+  _bb.writeVarInt(_data_f129);
+  return true;
+}
+
+size_t Struct::encodedSize() const {
+  size_t _size = 0;
+  if (f0() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f0);
+  }
+  if (f1() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f1);
+  }
+  if (f2() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f2);
+  }
+  if (f3() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f3);
+  }
+  if (f4() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f4);
+  }
+  if (f5() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f5);
+  }
+  if (f6() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f6);
+  }
+  if (f7() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f7);
+  }
+  if (f8() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f8);
+  }
+  if (f9() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f9);
+  }
+  if (f10() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f10);
+  }
+  if (f11() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f11);
+  }
+  if (f12() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f12);
+  }
+  if (f13() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f13);
+  }
+  if (f14() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f14);
+  }
+  if (f15() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f15);
+  }
+  if (f16() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f16);
+  }
+  if (f17() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f17);
+  }
+  if (f18() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f18);
+  }
+  if (f19() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f19);
+  }
+  if (f20() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f20);
+  }
+  if (f21() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f21);
+  }
+  if (f22() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f22);
+  }
+  if (f23() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f23);
+  }
+  if (f24() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f24);
+  }
+  if (f25() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f25);
+  }
+  if (f26() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f26);
+  }
+  if (f27() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f27);
+  }
+  if (f28() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f28);
+  }
+  if (f29() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f29);
+  }
+  if (f30() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f30);
+  }
+  if (f31() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f31);
+  }
+  if (f32() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f32);
+  }
+  if (f33() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f33);
+  }
+  if (f34() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f34);
+  }
+  if (f35() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f35);
+  }
+  if (f36() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f36);
+  }
+  if (f37() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f37);
+  }
+  if (f38() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f38);
+  }
+  if (f39() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f39);
+  }
+  if (f40() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f40);
+  }
+  if (f41() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f41);
+  }
+  if (f42() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f42);
+  }
+  if (f43() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f43);
+  }
+  if (f44() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f44);
+  }
+  if (f45() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f45);
+  }
+  if (f46() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f46);
+  }
+  if (f47() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f47);
+  }
+  if (f48() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f48);
+  }
+  if (f49() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f49);
+  }
+  if (f50() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f50);
+  }
+  if (f51() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f51);
+  }
+  if (f52() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f52);
+  }
+  if (f53() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f53);
+  }
+  if (f54() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f54);
+  }
+  if (f55() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f55);
+  }
+  if (f56() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f56);
+  }
+  if (f57() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f57);
+  }
+  if (f58() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f58);
+  }
+  if (f59() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f59);
+  }
+  if (f60() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f60);
+  }
+  if (f61() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f61);
+  }
+  if (f62() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f62);
+  }
+  if (f63() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f63);
+  }
+  if (f64() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f64);
+  }
+  if (f65() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f65);
+  }
+  if (f66() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f66);
+  }
+  if (f67() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f67);
+  }
+  if (f68() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f68);
+  }
+  if (f69() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f69);
+  }
+  if (f70() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f70);
+  }
+  if (f71() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f71);
+  }
+  if (f72() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f72);
+  }
+  if (f73() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f73);
+  }
+  if (f74() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f74);
+  }
+  if (f75() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f75);
+  }
+  if (f76() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f76);
+  }
+  if (f77() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f77);
+  }
+  if (f78() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f78);
+  }
+  if (f79() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f79);
+  }
+  if (f80() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f80);
+  }
+  if (f81() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f81);
+  }
+  if (f82() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f82);
+  }
+  if (f83() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f83);
+  }
+  if (f84() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f84);
+  }
+  if (f85() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f85);
+  }
+  if (f86() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f86);
+  }
+  if (f87() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f87);
+  }
+  if (f88() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f88);
+  }
+  if (f89() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f89);
+  }
+  if (f90() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f90);
+  }
+  if (f91() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f91);
+  }
+  if (f92() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f92);
+  }
+  if (f93() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f93);
+  }
+  if (f94() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f94);
+  }
+  if (f95() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f95);
+  }
+  if (f96() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f96);
+  }
+  if (f97() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f97);
+  }
+  if (f98() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f98);
+  }
+  if (f99() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f99);
+  }
+  if (f100() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f100);
+  }
+  if (f101() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f101);
+  }
+  if (f102() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f102);
+  }
+  if (f103() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f103);
+  }
+  if (f104() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f104);
+  }
+  if (f105() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f105);
+  }
+  if (f106() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f106);
+  }
+  if (f107() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f107);
+  }
+  if (f108() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f108);
+  }
+  if (f109() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f109);
+  }
+  if (f110() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f110);
+  }
+  if (f111() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f111);
+  }
+  if (f112() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f112);
+  }
+  if (f113() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f113);
+  }
+  if (f114() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f114);
+  }
+  if (f115() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f115);
+  }
+  if (f116() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f116);
+  }
+  if (f117() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f117);
+  }
+  if (f118() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f118);
+  }
+  if (f119() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f119);
+  }
+  if (f120() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f120);
+  }
+  if (f121() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f121);
+  }
+  if (f122() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f122);
+  }
+  if (f123() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f123);
+  }
+  if (f124() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f124);
+  }
+  if (f125() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f125);
+  }
+  if (f126() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f126);
+  }
+  if (f127() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f127);
+  }
+  if (f128() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f128);
+  }
+  if (f129() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_f129);
+  }
+  return _size;
+}
+
+bool Struct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
+  if (!_bb.readVarInt(_data_f0)) return false;
+  set_f0(_data_f0);
+  if (!_bb.readVarInt(_data_f1)) return false;
+  set_f1(_data_f1);
+  if (!_bb.readVarInt(_data_f2)) return false;
+  set_f2(_data_f2);
+  if (!_bb.readVarInt(_data_f3)) return false;
+  set_f3(_data_f3);
+  if (!_bb.readVarInt(_data_f4)) return false;
+  set_f4(_data_f4);
+  if (!_bb.readVarInt(_data_f5)) return false;
+  set_f5(_data_f5);
+  if (!_bb.readVarInt(_data_f6)) return false;
+  set_f6(_data_f6);
+  if (!_bb.readVarInt(_data_f7)) return false;
+  set_f7(_data_f7);
+  if (!_bb.readVarInt(_data_f8)) return false;
+  set_f8(_data_f8);
+  if (!_bb.readVarInt(_data_f9)) return false;
+  set_f9(_data_f9);
+  if (!_bb.readVarInt(_data_f10)) return false;
+  set_f10(_data_f10);
+  if (!_bb.readVarInt(_data_f11)) return false;
+  set_f11(_data_f11);
+  if (!_bb.readVarInt(_data_f12)) return false;
+  set_f12(_data_f12);
+  if (!_bb.readVarInt(_data_f13)) return false;
+  set_f13(_data_f13);
+  if (!_bb.readVarInt(_data_f14)) return false;
+  set_f14(_data_f14);
+  if (!_bb.readVarInt(_data_f15)) return false;
+  set_f15(_data_f15);
+  if (!_bb.readVarInt(_data_f16)) return false;
+  set_f16(_data_f16);
+  if (!_bb.readVarInt(_data_f17)) return false;
+  set_f17(_data_f17);
+  if (!_bb.readVarInt(_data_f18)) return false;
+  set_f18(_data_f18);
+  if (!_bb.readVarInt(_data_f19)) return false;
+  set_f19(_data_f19);
+  if (!_bb.readVarInt(_data_f20)) return false;
+  set_f20(_data_f20);
+  if (!_bb.readVarInt(_data_f21)) return false;
+  set_f21(_data_f21);
+  if (!_bb.readVarInt(_data_f22)) return false;
+  set_f22(_data_f22);
+  if (!_bb.readVarInt(_data_f23)) return false;
+  set_f23(_data_f23);
+  if (!_bb.readVarInt(_data_f24)) return false;
+  set_f24(_data_f24);
+  if (!_bb.readVarInt(_data_f25)) return false;
+  set_f25(_data_f25);
+  if (!_bb.readVarInt(_data_f26)) return false;
+  set_f26(_data_f26);
+  if (!_bb.readVarInt(_data_f27)) return false;
+  set_f27(_data_f27);
+  if (!_bb.readVarInt(_data_f28)) return false;
+  set_f28(_data_f28);
+  if (!_bb.readVarInt(_data_f29)) return false;
+  set_f29(_data_f29);
+  if (!_bb.readVarInt(_data_f30)) return false;
+  set_f30(_data_f30);
+  if (!_bb.readVarInt(_data_f31)) return false;
+  set_f31(_data_f31);
+  if (!_bb.readVarInt(_data_f32)) return false;
+  set_f32(_data_f32);
+  if (!_bb.readVarInt(_data_f33)) return false;
+  set_f33(_data_f33);
+  if (!_bb.readVarInt(_data_f34)) return false;
+  set_f34(_data_f34);
+  if (!_bb.readVarInt(_data_f35)) return false;
+  set_f35(_data_f35);
+  if (!_bb.readVarInt(_data_f36)) return false;
+  set_f36(_data_f36);
+  if (!_bb.readVarInt(_data_f37)) return false;
+  set_f37(_data_f37);
+  if (!_bb.readVarInt(_data_f38)) return false;
+  set_f38(_data_f38);
+  if (!_bb.readVarInt(_data_f39)) return false;
+  set_f39(_data_f39);
+  if (!_bb.readVarInt(_data_f40)) return false;
+  set_f40(_data_f40);
+  if (!_bb.readVarInt(_data_f41)) return false;
+  set_f41(_data_f41);
+  if (!_bb.readVarInt(_data_f42)) return false;
+  set_f42(_data_f42);
+  if (!_bb.readVarInt(_data_f43)) return false;
+  set_f43(_data_f43);
+  if (!_bb.readVarInt(_data_f44)) return false;
+  set_f44(_data_f44);
+  if (!_bb.readVarInt(_data_f45)) return false;
+  set_f45(_data_f45);
+  if (!_bb.readVarInt(_data_f46)) return false;
+  set_f46(_data_f46);
+  if (!_bb.readVarInt(_data_f47)) return false;
+  set_f47(_data_f47);
+  if (!_bb.readVarInt(_data_f48)) return false;
+  set_f48(_data_f48);
+  if (!_bb.readVarInt(_data_f49)) return false;
+  set_f49(_data_f49);
+  if (!_bb.readVarInt(_data_f50)) return false;
+  set_f50(_data_f50);
+  if (!_bb.readVarInt(_data_f51)) return false;
+  set_f51(_data_f51);
+  if (!_bb.readVarInt(_data_f52)) return false;
+  set_f52(_data_f52);
+  if (!_bb.readVarInt(_data_f53)) return false;
+  set_f53(_data_f53);
+  if (!_bb.readVarInt(_data_f54)) return false;
+  set_f54(_data_f54);
+  if (!_bb.readVarInt(_data_f55)) return false;
+  set_f55(_data_f55);
+  if (!_bb.readVarInt(_data_f56)) return false;
+  set_f56(_data_f56);
+  if (!_bb.readVarInt(_data_f57)) return false;
   set_f57(_data_f57);
   if (!_bb.readVarInt(_data_f58)) return false;
   set_f58(_data_f58);
@@ -5002,532 +5562,927 @@ void Message::set_f129(const int32_t &value) {
   _flags[4] |= 2; _data_f129 = value;
 }
 
-bool Message::encode(kiwi::ByteBuffer &_bb) {
+bool Message::encode(kiwi::ByteBuffer &_bb) {
+  if (f0() != nullptr) {
+    _bb.writeVarUint(1);
+    _bb.writeVarInt(_data_f0);
+  }
+  if (f1() != nullptr) {
+    _bb.writeVarUint(2);
+    _bb.writeVarInt(_data_f1);
+  }
+  if (f2() != nullptr) {
+    _bb.writeVarUint(3);
+    _bb.writeVarInt(_data_f2);
+  }
+  if (f3() != nullptr) {
+    _bb.writeVarUint(4);
+    _bb.writeVarInt(_data_f3);
+  }
+  if (f4() != nullptr) {
+    _bb.writeVarUint(5);
+    _bb.writeVarInt(_data_f4);
+  }
+  if (f5() != nullptr) {
+    _bb.writeVarUint(6);
+    _bb.writeVarInt(_data_f5);
+  }
+  if (f6() != nullptr) {
+    _bb.writeVarUint(7);
+    _bb.writeVarInt(_data_f6);
+  }
+  if (f7() != nullptr) {
+    _bb.writeVarUint(8);
+    _bb.writeVarInt(_data_f7);
+  }
+  if (f8() != nullptr) {
+    _bb.writeVarUint(9);
+    _bb.writeVarInt(_data_f8);
+  }
+  if (f9() != nullptr) {
+    _bb.writeVarUint(10);
+    _bb.writeVarInt(_data_f9);
+  }
+  if (f10() != nullptr) {
+    _bb.writeVarUint(11);
+    _bb.writeVarInt(_data_f10);
+  }
+  if (f11() != nullptr) {
+    _bb.writeVarUint(12);
+    _bb.writeVarInt(_data_f11);
+  }
+  if (f12() != nullptr) {
+    _bb.writeVarUint(13);
+    _bb.writeVarInt(_data_f12);
+  }
+  if (f13() != nullptr) {
+    _bb.writeVarUint(14);
+    _bb.writeVarInt(_data_f13);
+  }
+  if (f14() != nullptr) {
+    _bb.writeVarUint(15);
+    _bb.writeVarInt(_data_f14);
+  }
+  if (f15() != nullptr) {
+    _bb.writeVarUint(16);
+    _bb.writeVarInt(_data_f15);
+  }
+  if (f16() != nullptr) {
+    _bb.writeVarUint(17);
+    _bb.writeVarInt(_data_f16);
+  }
+  if (f17() != nullptr) {
+    _bb.writeVarUint(18);
+    _bb.writeVarInt(_data_f17);
+  }
+  if (f18() != nullptr) {
+    _bb.writeVarUint(19);
+    _bb.writeVarInt(_data_f18);
+  }
+  if (f19() != nullptr) {
+    _bb.writeVarUint(20);
+    _bb.writeVarInt(_data_f19);
+  }
+  if (f20() != nullptr) {
+    _bb.writeVarUint(21);
+    _bb.writeVarInt(_data_f20);
+  }
+  if (f21() != nullptr) {
+    _bb.writeVarUint(22);
+    _bb.writeVarInt(_data_f21);
+  }
+  if (f22() != nullptr) {
+    _bb.writeVarUint(23);
+    _bb.writeVarInt(_data_f22);
+  }
+  if (f23() != nullptr) {
+    _bb.writeVarUint(24);
+    _bb.writeVarInt(_data_f23);
+  }
+  if (f24() != nullptr) {
+    _bb.writeVarUint(25);
+    _bb.writeVarInt(_data_f24);
+  }
+  if (f25() != nullptr) {
+    _bb.writeVarUint(26);
+    _bb.writeVarInt(_data_f25);
+  }
+  if (f26() != nullptr) {
+    _bb.writeVarUint(27);
+    _bb.writeVarInt(_data_f26);
+  }
+  if (f27() != nullptr) {
+    _bb.writeVarUint(28);
+    _bb.writeVarInt(_data_f27);
+  }
+  if (f28() != nullptr) {
+    _bb.writeVarUint(29);
+    _bb.writeVarInt(_data_f28);
+  }
+  if (f29() != nullptr) {
+    _bb.writeVarUint(30);
+    _bb.writeVarInt(_data_f29);
+  }
+  if (f30() != nullptr) {
+    _bb.writeVarUint(31);
+    _bb.writeVarInt(_data_f30);
+  }
+  if (f31() != nullptr) {
+    _bb.writeVarUint(32);
+    _bb.writeVarInt(_data_f31);
+  }
+  if (f32() != nullptr) {
+    _bb.writeVarUint(33);
+    _bb.writeVarInt(_data_f32);
+  }
+  if (f33() != nullptr) {
+    _bb.writeVarUint(34);
+    _bb.writeVarInt(_data_f33);
+  }
+  if (f34() != nullptr) {
+    _bb.writeVarUint(35);
+    _bb.writeVarInt(_data_f34);
+  }
+  if (f35() != nullptr) {
+    _bb.writeVarUint(36);
+    _bb.writeVarInt(_data_f35);
+  }
+  if (f36() != nullptr) {
+    _bb.writeVarUint(37);
+    _bb.writeVarInt(_data_f36);
+  }
+  if (f37() != nullptr) {
+    _bb.writeVarUint(38);
+    _bb.writeVarInt(_data_f37);
+  }
+  if (f38() != nullptr) {
+    _bb.writeVarUint(39);
+    _bb.writeVarInt(_data_f38);
+  }
+  if (f39() != nullptr) {
+    _bb.writeVarUint(40);
+    _bb.writeVarInt(_data_f39);
+  }
+  if (f40() != nullptr) {
+    _bb.writeVarUint(41);
+    _bb.writeVarInt(_data_f40);
+  }
+  if (f41() != nullptr) {
+    _bb.writeVarUint(42);
+    _bb.writeVarInt(_data_f41);
+  }
+  if (f42() != nullptr) {
+    _bb.writeVarUint(43);
+    _bb.writeVarInt(_data_f42);
+  }
+  if (f43() != nullptr) {
+    _bb.writeVarUint(44);
+    _bb.writeVarInt(_data_f43);
+  }
+  if (f44() != nullptr) {
+    _bb.writeVarUint(45);
+    _bb.writeVarInt(_data_f44);
+  }
+  if (f45() != nullptr) {
+    _bb.writeVarUint(46);
+    _bb.writeVarInt(_data_f45);
+  }
+  if (f46() != nullptr) {
+    _bb.writeVarUint(47);
+    _bb.writeVarInt(_data_f46);
+  }
+  if (f47() != nullptr) {
+    _bb.writeVarUint(48);
+    _bb.writeVarInt(_data_f47);
+  }
+  if (f48() != nullptr) {
+    _bb.writeVarUint(49);
+    _bb.writeVarInt(_data_f48);
+  }
+  if (f49() != nullptr) {
+    _bb.writeVarUint(50);
+    _bb.writeVarInt(_data_f49);
+  }
+  if (f50() != nullptr) {
+    _bb.writeVarUint(51);
+    _bb.writeVarInt(_data_f50);
+  }
+  if (f51() != nullptr) {
+    _bb.writeVarUint(52);
+    _bb.writeVarInt(_data_f51);
+  }
+  if (f52() != nullptr) {
+    _bb.writeVarUint(53);
+    _bb.writeVarInt(_data_f52);
+  }
+  if (f53() != nullptr) {
+    _bb.writeVarUint(54);
+    _bb.writeVarInt(_data_f53);
+  }
+  if (f54() != nullptr) {
+    _bb.writeVarUint(55);
+    _bb.writeVarInt(_data_f54);
+  }
+  if (f55() != nullptr) {
+    _bb.writeVarUint(56);
+    _bb.writeVarInt(_data_f55);
+  }
+  if (f56() != nullptr) {
+    _bb.writeVarUint(57);
+    _bb.writeVarInt(_data_f56);
+  }
+  if (f57() != nullptr) {
+    _bb.writeVarUint(58);
+    _bb.writeVarInt(_data_f57);
+  }
+  if (f58() != nullptr) {
+    _bb.writeVarUint(59);
+    _bb.writeVarInt(_data_f58);
+  }
+  if (f59() != nullptr) {
+    _bb.writeVarUint(60);
+    _bb.writeVarInt(_data_f59);
+  }
+  if (f60() != nullptr) {
+    _bb.writeVarUint(61);
+    _bb.writeVarInt(_data_f60);
+  }
+  if (f61() != nullptr) {
+    _bb.writeVarUint(62);
+    _bb.writeVarInt(_data_f61);
+  }
+  if (f62() != nullptr) {
+    _bb.writeVarUint(63);
+    _bb.writeVarInt(_data_f62);
+  }
+  if (f63() != nullptr) {
+    _bb.writeVarUint(64);
+    _bb.writeVarInt(_data_f63);
+  }
+  if (f64() != nullptr) {
+    _bb.writeVarUint(65);
+    _bb.writeVarInt(_data_f64);
+  }
+  if (f65() != nullptr) {
+    _bb.writeVarUint(66);
+    _bb.writeVarInt(_data_f65);
+  }
+  if (f66() != nullptr) {
+    _bb.writeVarUint(67);
+    _bb.writeVarInt(_data_f66);
+  }
+  if (f67() != nullptr) {
+    _bb.writeVarUint(68);
+    _bb.writeVarInt(_data_f67);
+  }
+  if (f68() != nullptr) {
+    _bb.writeVarUint(69);
+    _bb.writeVarInt(_data_f68);
+  }
+  if (f69() != nullptr) {
+    _bb.writeVarUint(70);
+    _bb.writeVarInt(_data_f69);
+  }
+  if (f70() != nullptr) {
+    _bb.writeVarUint(71);
+    _bb.writeVarInt(_data_f70);
+  }
+  if (f71() != nullptr) {
+    _bb.writeVarUint(72);
+    _bb.writeVarInt(_data_f71);
+  }
+  if (f72() != nullptr) {
+    _bb.writeVarUint(73);
+    _bb.writeVarInt(_data_f72);
+  }
+  if (f73() != nullptr) {
+    _bb.writeVarUint(74);
+    _bb.writeVarInt(_data_f73);
+  }
+  if (f74() != nullptr) {
+    _bb.writeVarUint(75);
+    _bb.writeVarInt(_data_f74);
+  }
+  if (f75() != nullptr) {
+    _bb.writeVarUint(76);
+    _bb.writeVarInt(_data_f75);
+  }
+  if (f76() != nullptr) {
+    _bb.writeVarUint(77);
+    _bb.writeVarInt(_data_f76);
+  }
+  if (f77() != nullptr) {
+    _bb.writeVarUint(78);
+    _bb.writeVarInt(_data_f77);
+  }
+  if (f78() != nullptr) {
+    _bb.writeVarUint(79);
+    _bb.writeVarInt(_data_f78);
+  }
+  if (f79() != nullptr) {
+    _bb.writeVarUint(80);
+    _bb.writeVarInt(_data_f79);
+  }
+  if (f80() != nullptr) {
+    _bb.writeVarUint(81);
+    _bb.writeVarInt(_data_f80);
+  }
+  if (f81() != nullptr) {
+    _bb.writeVarUint(82);
+    _bb.writeVarInt(_data_f81);
+  }
+  if (f82() != nullptr) {
+    _bb.writeVarUint(83);
+    _bb.writeVarInt(_data_f82);
+  }
+  if (f83() != nullptr) {
+    _bb.writeVarUint(84);
+    _bb.writeVarInt(_data_f83);
+  }
+  if (f84() != nullptr) {
+    _bb.writeVarUint(85);
+    _bb.writeVarInt(_data_f84);
+  }
+  if (f85() != nullptr) {
+    _bb.writeVarUint(86);
+    _bb.writeVarInt(_data_f85);
+  }
+  if (f86() != nullptr) {
+    _bb.writeVarUint(87);
+    _bb.writeVarInt(_data_f86);
+  }
+  if (f87() != nullptr) {
+    _bb.writeVarUint(88);
+    _bb.writeVarInt(_data_f87);
+  }
+  if (f88() != nullptr) {
+    _bb.writeVarUint(89);
+    _bb.writeVarInt(_data_f88);
+  }
+  if (f89() != nullptr) {
+    _bb.writeVarUint(90);
+    _bb.writeVarInt(_data_f89);
+  }
+  if (f90() != nullptr) {
+    _bb.writeVarUint(91);
+    _bb.writeVarInt(_data_f90);
+  }
+  if (f91() != nullptr) {
+    _bb.writeVarUint(92);
+    _bb.writeVarInt(_data_f91);
+  }
+  if (f92() != nullptr) {
+    _bb.writeVarUint(93);
+    _bb.writeVarInt(_data_f92);
+  }
+  if (f93() != nullptr) {
+    _bb.writeVarUint(94);
+    _bb.writeVarInt(_data_f93);
+  }
+  if (f94() != nullptr) {
+    _bb.writeVarUint(95);
+    _bb.writeVarInt(_data_f94);
+  }
+  if (f95() != nullptr) {
+    _bb.writeVarUint(96);
+    _bb.writeVarInt(_data_f95);
+  }
+  if (f96() != nullptr) {
+    _bb.writeVarUint(97);
+    _bb.writeVarInt(_data_f96);
+  }
+  if (f97() != nullptr) {
+    _bb.writeVarUint(98);
+    _bb.writeVarInt(_data_f97);
+  }
+  if (f98() != nullptr) {
+    _bb.writeVarUint(99);
+    _bb.writeVarInt(_data_f98);
+  }
+  if (f99() != nullptr) {
+    _bb.writeVarUint(100);
+    _bb.writeVarInt(_data_f99);
+  }
+  if (f100() != nullptr) {
+    _bb.writeVarUint(101);
+    _bb.writeVarInt(_data_f100);
+  }
+  if (f101() != nullptr) {
+    _bb.writeVarUint(102);
+    _bb.writeVarInt(_data_f101);
+  }
+  if (f102() != nullptr) {
+    _bb.writeVarUint(103);
+    _bb.writeVarInt(_data_f102);
+  }
+  if (f103() != nullptr) {
+    _bb.writeVarUint(104);
+    _bb.writeVarInt(_data_f103);
+  }
+  if (f104() != nullptr) {
+    _bb.writeVarUint(105);
+    _bb.writeVarInt(_data_f104);
+  }
+  if (f105() != nullptr) {
+    _bb.writeVarUint(106);
+    _bb.writeVarInt(_data_f105);
+  }
+  if (f106() != nullptr) {
+    _bb.writeVarUint(107);
+    _bb.writeVarInt(_data_f106);
+  }
+  if (f107() != nullptr) {
+    _bb.writeVarUint(108);
+    _bb.writeVarInt(_data_f107);
+  }
+  if (f108() != nullptr) {
+    _bb.writeVarUint(109);
+    _bb.writeVarInt(_data_f108);
+  }
+  if (f109() != nullptr) {
+    _bb.writeVarUint(110);
+    _bb.writeVarInt(_data_f109);
+  }
+  if (f110() != nullptr) {
+    _bb.writeVarUint(111);
+    _bb.writeVarInt(_data_f110);
+  }
+  if (f111() != nullptr) {
+    _bb.writeVarUint(112);
+    _bb.writeVarInt(_data_f111);
+  }
+  if (f112() != nullptr) {
+    _bb.writeVarUint(113);
+    _bb.writeVarInt(_data_f112);
+  }
+  if (f113() != nullptr) {
+    _bb.writeVarUint(114);
+    _bb.writeVarInt(_data_f113);
+  }
+  if (f114() != nullptr) {
+    _bb.writeVarUint(115);
+    _bb.writeVarInt(_data_f114);
+  }
+  if (f115() != nullptr) {
+    _bb.writeVarUint(116);
+    _bb.writeVarInt(_data_f115);
+  }
+  if (f116() != nullptr) {
+    _bb.writeVarUint(117);
+    _bb.writeVarInt(_data_f116);
+  }
+  if (f117() != nullptr) {
+    _bb.writeVarUint(118);
+    _bb.writeVarInt(_data_f117);
+  }
+  if (f118() != nullptr) {
+    _bb.writeVarUint(119);
+    _bb.writeVarInt(_data_f118);
+  }
+  if (f119() != nullptr) {
+    _bb.writeVarUint(120);
+    _bb.writeVarInt(_data_f119);
+  }
+  if (f120() != nullptr) {
+    _bb.writeVarUint(121);
+    _bb.writeVarInt(_data_f120);
+  }
+  if (f121() != nullptr) {
+    _bb.writeVarUint(122);
+    _bb.writeVarInt(_data_f121);
+  }
+  if (f122() != nullptr) {
+    _bb.writeVarUint(123);
+    _bb.writeVarInt(_data_f122);
+  }
+  if (f123() != nullptr) {
+    _bb.writeVarUint(124);
+    _bb.writeVarInt(_data_f123);
+  }
+  if (f124() != nullptr) {
+    _bb.writeVarUint(125);
+    _bb.writeVarInt(_data_f124);
+  }
+  if (f125() != nullptr) {
+    _bb.writeVarUint(126);
+    _bb.writeVarInt(_data_f125);
+  }
+  if (f126() != nullptr) {
+    _bb.writeVarUint(127);
+    _bb.writeVarInt(_data_f126);
+  }
+  if (f127() != nullptr) {
+    _bb.writeVarUint(128);
+    _bb.writeVarInt(_data_f127);
+  }
+  if (f128() != nullptr) {
+    _bb.writeVarUint(129);
+    _bb.writeVarInt(_data_f128);
+  }
+  if (f129() != nullptr) {
+    _bb.writeVarUint(130);
+    _bb.writeVarInt(_data_f129);
+  }
+  _bb.writeVarUint(0);
+  return true;
+}
+
+size_t Message::encodedSize() const {
+  size_t _size = 1;
   if (f0() != nullptr) {
-    _bb.writeVarUint(1);
-    _bb.writeVarInt(_data_f0);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f0);
   }
   if (f1() != nullptr) {
-    _bb.writeVarUint(2);
-    _bb.writeVarInt(_data_f1);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f1);
   }
   if (f2() != nullptr) {
-    _bb.writeVarUint(3);
-    _bb.writeVarInt(_data_f2);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f2);
   }
   if (f3() != nullptr) {
-    _bb.writeVarUint(4);
-    _bb.writeVarInt(_data_f3);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f3);
   }
   if (f4() != nullptr) {
-    _bb.writeVarUint(5);
-    _bb.writeVarInt(_data_f4);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f4);
   }
   if (f5() != nullptr) {
-    _bb.writeVarUint(6);
-    _bb.writeVarInt(_data_f5);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f5);
   }
   if (f6() != nullptr) {
-    _bb.writeVarUint(7);
-    _bb.writeVarInt(_data_f6);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f6);
   }
   if (f7() != nullptr) {
-    _bb.writeVarUint(8);
-    _bb.writeVarInt(_data_f7);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f7);
   }
   if (f8() != nullptr) {
-    _bb.writeVarUint(9);
-    _bb.writeVarInt(_data_f8);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f8);
   }
   if (f9() != nullptr) {
-    _bb.writeVarUint(10);
-    _bb.writeVarInt(_data_f9);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f9);
   }
   if (f10() != nullptr) {
-    _bb.writeVarUint(11);
-    _bb.writeVarInt(_data_f10);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f10);
   }
   if (f11() != nullptr) {
-    _bb.writeVarUint(12);
-    _bb.writeVarInt(_data_f11);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f11);
   }
   if (f12() != nullptr) {
-    _bb.writeVarUint(13);
-    _bb.writeVarInt(_data_f12);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f12);
   }
   if (f13() != nullptr) {
-    _bb.writeVarUint(14);
-    _bb.writeVarInt(_data_f13);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f13);
   }
   if (f14() != nullptr) {
-    _bb.writeVarUint(15);
-    _bb.writeVarInt(_data_f14);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f14);
   }
   if (f15() != nullptr) {
-    _bb.writeVarUint(16);
-    _bb.writeVarInt(_data_f15);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f15);
   }
   if (f16() != nullptr) {
-    _bb.writeVarUint(17);
-    _bb.writeVarInt(_data_f16);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f16);
   }
   if (f17() != nullptr) {
-    _bb.writeVarUint(18);
-    _bb.writeVarInt(_data_f17);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f17);
   }
   if (f18() != nullptr) {
-    _bb.writeVarUint(19);
-    _bb.writeVarInt(_data_f18);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f18);
   }
   if (f19() != nullptr) {
-    _bb.writeVarUint(20);
-    _bb.writeVarInt(_data_f19);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f19);
   }
   if (f20() != nullptr) {
-    _bb.writeVarUint(21);
-    _bb.writeVarInt(_data_f20);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f20);
   }
   if (f21() != nullptr) {
-    _bb.writeVarUint(22);
-    _bb.writeVarInt(_data_f21);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f21);
   }
   if (f22() != nullptr) {
-    _bb.writeVarUint(23);
-    _bb.writeVarInt(_data_f22);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f22);
   }
   if (f23() != nullptr) {
-    _bb.writeVarUint(24);
-    _bb.writeVarInt(_data_f23);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f23);
   }
   if (f24() != nullptr) {
-    _bb.writeVarUint(25);
-    _bb.writeVarInt(_data_f24);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f24);
   }
   if (f25() != nullptr) {
-    _bb.writeVarUint(26);
-    _bb.writeVarInt(_data_f25);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f25);
   }
   if (f26() != nullptr) {
-    _bb.writeVarUint(27);
-    _bb.writeVarInt(_data_f26);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f26);
   }
   if (f27() != nullptr) {
-    _bb.writeVarUint(28);
-    _bb.writeVarInt(_data_f27);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f27);
   }
   if (f28() != nullptr) {
-    _bb.writeVarUint(29);
-    _bb.writeVarInt(_data_f28);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f28);
   }
   if (f29() != nullptr) {
-    _bb.writeVarUint(30);
-    _bb.writeVarInt(_data_f29);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f29);
   }
   if (f30() != nullptr) {
-    _bb.writeVarUint(31);
-    _bb.writeVarInt(_data_f30);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f30);
   }
   if (f31() != nullptr) {
-    _bb.writeVarUint(32);
-    _bb.writeVarInt(_data_f31);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f31);
   }
   if (f32() != nullptr) {
-    _bb.writeVarUint(33);
-    _bb.writeVarInt(_data_f32);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f32);
   }
   if (f33() != nullptr) {
-    _bb.writeVarUint(34);
-    _bb.writeVarInt(_data_f33);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f33);
   }
   if (f34() != nullptr) {
-    _bb.writeVarUint(35);
-    _bb.writeVarInt(_data_f34);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f34);
   }
   if (f35() != nullptr) {
-    _bb.writeVarUint(36);
-    _bb.writeVarInt(_data_f35);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f35);
   }
   if (f36() != nullptr) {
-    _bb.writeVarUint(37);
-    _bb.writeVarInt(_data_f36);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f36);
   }
   if (f37() != nullptr) {
-    _bb.writeVarUint(38);
-    _bb.writeVarInt(_data_f37);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f37);
   }
   if (f38() != nullptr) {
-    _bb.writeVarUint(39);
-    _bb.writeVarInt(_data_f38);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f38);
   }
   if (f39() != nullptr) {
-    _bb.writeVarUint(40);
-    _bb.writeVarInt(_data_f39);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f39);
   }
   if (f40() != nullptr) {
-    _bb.writeVarUint(41);
-    _bb.writeVarInt(_data_f40);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f40);
   }
   if (f41() != nullptr) {
-    _bb.writeVarUint(42);
-    _bb.writeVarInt(_data_f41);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f41);
   }
   if (f42() != nullptr) {
-    _bb.writeVarUint(43);
-    _bb.writeVarInt(_data_f42);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f42);
   }
   if (f43() != nullptr) {
-    _bb.writeVarUint(44);
-    _bb.writeVarInt(_data_f43);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f43);
   }
   if (f44() != nullptr) {
-    _bb.writeVarUint(45);
-    _bb.writeVarInt(_data_f44);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f44);
   }
   if (f45() != nullptr) {
-    _bb.writeVarUint(46);
-    _bb.writeVarInt(_data_f45);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f45);
   }
   if (f46() != nullptr) {
-    _bb.writeVarUint(47);
-    _bb.writeVarInt(_data_f46);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f46);
   }
   if (f47() != nullptr) {
-    _bb.writeVarUint(48);
-    _bb.writeVarInt(_data_f47);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f47);
   }
   if (f48() != nullptr) {
-    _bb.writeVarUint(49);
-    _bb.writeVarInt(_data_f48);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f48);
   }
   if (f49() != nullptr) {
-    _bb.writeVarUint(50);
-    _bb.writeVarInt(_data_f49);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f49);
   }
   if (f50() != nullptr) {
-    _bb.writeVarUint(51);
-    _bb.writeVarInt(_data_f50);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f50);
   }
   if (f51() != nullptr) {
-    _bb.writeVarUint(52);
-    _bb.writeVarInt(_data_f51);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f51);
   }
   if (f52() != nullptr) {
-    _bb.writeVarUint(53);
-    _bb.writeVarInt(_data_f52);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f52);
   }
   if (f53() != nullptr) {
-    _bb.writeVarUint(54);
-    _bb.writeVarInt(_data_f53);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f53);
   }
   if (f54() != nullptr) {
-    _bb.writeVarUint(55);
-    _bb.writeVarInt(_data_f54);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f54);
   }
   if (f55() != nullptr) {
-    _bb.writeVarUint(56);
-    _bb.writeVarInt(_data_f55);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f55);
   }
   if (f56() != nullptr) {
-    _bb.writeVarUint(57);
-    _bb.writeVarInt(_data_f56);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f56);
   }
   if (f57() != nullptr) {
-    _bb.writeVarUint(58);
-    _bb.writeVarInt(_data_f57);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f57);
   }
   if (f58() != nullptr) {
-    _bb.writeVarUint(59);
-    _bb.writeVarInt(_data_f58);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f58);
   }
   if (f59() != nullptr) {
-    _bb.writeVarUint(60);
-    _bb.writeVarInt(_data_f59);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f59);
   }
   if (f60() != nullptr) {
-    _bb.writeVarUint(61);
-    _bb.writeVarInt(_data_f60);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f60);
   }
   if (f61() != nullptr) {
-    _bb.writeVarUint(62);
-    _bb.writeVarInt(_data_f61);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f61);
   }
   if (f62() != nullptr) {
-    _bb.writeVarUint(63);
-    _bb.writeVarInt(_data_f62);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f62);
   }
   if (f63() != nullptr) {
-    _bb.writeVarUint(64);
-    _bb.writeVarInt(_data_f63);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f63);
   }
   if (f64() != nullptr) {
-    _bb.writeVarUint(65);
-    _bb.writeVarInt(_data_f64);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f64);
   }
   if (f65() != nullptr) {
-    _bb.writeVarUint(66);
-    _bb.writeVarInt(_data_f65);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f65);
   }
   if (f66() != nullptr) {
-    _bb.writeVarUint(67);
-    _bb.writeVarInt(_data_f66);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f66);
   }
   if (f67() != nullptr) {
-    _bb.writeVarUint(68);
-    _bb.writeVarInt(_data_f67);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f67);
   }
   if (f68() != nullptr) {
-    _bb.writeVarUint(69);
-    _bb.writeVarInt(_data_f68);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f68);
   }
   if (f69() != nullptr) {
-    _bb.writeVarUint(70);
-    _bb.writeVarInt(_data_f69);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f69);
   }
   if (f70() != nullptr) {
-    _bb.writeVarUint(71);
-    _bb.writeVarInt(_data_f70);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f70);
   }
   if (f71() != nullptr) {
-    _bb.writeVarUint(72);
-    _bb.writeVarInt(_data_f71);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f71);
   }
   if (f72() != nullptr) {
-    _bb.writeVarUint(73);
-    _bb.writeVarInt(_data_f72);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f72);
   }
   if (f73() != nullptr) {
-    _bb.writeVarUint(74);
-    _bb.writeVarInt(_data_f73);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f73);
   }
   if (f74() != nullptr) {
-    _bb.writeVarUint(75);
-    _bb.writeVarInt(_data_f74);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f74);
   }
   if (f75() != nullptr) {
-    _bb.writeVarUint(76);
-    _bb.writeVarInt(_data_f75);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f75);
   }
   if (f76() != nullptr) {
-    _bb.writeVarUint(77);
-    _bb.writeVarInt(_data_f76);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f76);
   }
   if (f77() != nullptr) {
-    _bb.writeVarUint(78);
-    _bb.writeVarInt(_data_f77);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f77);
   }
   if (f78() != nullptr) {
-    _bb.writeVarUint(79);
-    _bb.writeVarInt(_data_f78);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f78);
   }
   if (f79() != nullptr) {
-    _bb.writeVarUint(80);
-    _bb.writeVarInt(_data_f79);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f79);
   }
   if (f80() != nullptr) {
-    _bb.writeVarUint(81);
-    _bb.writeVarInt(_data_f80);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f80);
   }
   if (f81() != nullptr) {
-    _bb.writeVarUint(82);
-    _bb.writeVarInt(_data_f81);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f81);
   }
   if (f82() != nullptr) {
-    _bb.writeVarUint(83);
-    _bb.writeVarInt(_data_f82);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f82);
   }
   if (f83() != nullptr) {
-    _bb.writeVarUint(84);
-    _bb.writeVarInt(_data_f83);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f83);
   }
   if (f84() != nullptr) {
-    _bb.writeVarUint(85);
-    _bb.writeVarInt(_data_f84);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f84);
   }
   if (f85() != nullptr) {
-    _bb.writeVarUint(86);
-    _bb.writeVarInt(_data_f85);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f85);
   }
   if (f86() != nullptr) {
-    _bb.writeVarUint(87);
-    _bb.writeVarInt(_data_f86);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f86);
   }
   if (f87() != nullptr) {
-    _bb.writeVarUint(88);
-    _bb.writeVarInt(_data_f87);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f87);
   }
   if (f88() != nullptr) {
-    _bb.writeVarUint(89);
-    _bb.writeVarInt(_data_f88);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f88);
   }
   if (f89() != nullptr) {
-    _bb.writeVarUint(90);
-    _bb.writeVarInt(_data_f89);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f89);
   }
   if (f90() != nullptr) {
-    _bb.writeVarUint(91);
-    _bb.writeVarInt(_data_f90);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f90);
   }
   if (f91() != nullptr) {
-    _bb.writeVarUint(92);
-    _bb.writeVarInt(_data_f91);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f91);
   }
   if (f92() != nullptr) {
-    _bb.writeVarUint(93);
-    _bb.writeVarInt(_data_f92);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f92);
   }
   if (f93() != nullptr) {
-    _bb.writeVarUint(94);
-    _bb.writeVarInt(_data_f93);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f93);
   }
   if (f94() != nullptr) {
-    _bb.writeVarUint(95);
-    _bb.writeVarInt(_data_f94);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f94);
   }
   if (f95() != nullptr) {
-    _bb.writeVarUint(96);
-    _bb.writeVarInt(_data_f95);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f95);
   }
   if (f96() != nullptr) {
-    _bb.writeVarUint(97);
-    _bb.writeVarInt(_data_f96);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f96);
   }
   if (f97() != nullptr) {
-    _bb.writeVarUint(98);
-    _bb.writeVarInt(_data_f97);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f97);
   }
   if (f98() != nullptr) {
-    _bb.writeVarUint(99);
-    _bb.writeVarInt(_data_f98);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f98);
   }
   if (f99() != nullptr) {
-    _bb.writeVarUint(100);
-    _bb.writeVarInt(_data_f99);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f99);
   }
   if (f100() != nullptr) {
-    _bb.writeVarUint(101);
-    _bb.writeVarInt(_data_f100);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f100);
   }
   if (f101() != nullptr) {
-    _bb.writeVarUint(102);
-    _bb.writeVarInt(_data_f101);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f101);
   }
   if (f102() != nullptr) {
-    _bb.writeVarUint(103);
-    _bb.writeVarInt(_data_f102);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f102);
   }
   if (f103() != nullptr) {
-    _bb.writeVarUint(104);
-    _bb.writeVarInt(_data_f103);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f103);
   }
   if (f104() != nullptr) {
-    _bb.writeVarUint(105);
-    _bb.writeVarInt(_data_f104);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f104);
   }
   if (f105() != nullptr) {
-    _bb.writeVarUint(106);
-    _bb.writeVarInt(_data_f105);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f105);
   }
   if (f106() != nullptr) {
-    _bb.writeVarUint(107);
-    _bb.writeVarInt(_data_f106);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f106);
   }
   if (f107() != nullptr) {
-    _bb.writeVarUint(108);
-    _bb.writeVarInt(_data_f107);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f107);
   }
   if (f108() != nullptr) {
-    _bb.writeVarUint(109);
-    _bb.writeVarInt(_data_f108);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f108);
   }
   if (f109() != nullptr) {
-    _bb.writeVarUint(110);
-    _bb.writeVarInt(_data_f109);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f109);
   }
   if (f110() != nullptr) {
-    _bb.writeVarUint(111);
-    _bb.writeVarInt(_data_f110);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f110);
   }
   if (f111() != nullptr) {
-    _bb.writeVarUint(112);
-    _bb.writeVarInt(_data_f111);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f111);
   }
   if (f112() != nullptr) {
-    _bb.writeVarUint(113);
-    _bb.writeVarInt(_data_f112);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f112);
   }
   if (f113() != nullptr) {
-    _bb.writeVarUint(114);
-    _bb.writeVarInt(_data_f113);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f113);
   }
   if (f114() != nullptr) {
-    _bb.writeVarUint(115);
-    _bb.writeVarInt(_data_f114);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f114);
   }
   if (f115() != nullptr) {
-    _bb.writeVarUint(116);
-    _bb.writeVarInt(_data_f115);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f115);
   }
   if (f116() != nullptr) {
-    _bb.writeVarUint(117);
-    _bb.writeVarInt(_data_f116);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f116);
   }
   if (f117() != nullptr) {
-    _bb.writeVarUint(118);
-    _bb.writeVarInt(_data_f117);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f117);
   }
   if (f118() != nullptr) {
-    _bb.writeVarUint(119);
-    _bb.writeVarInt(_data_f118);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f118);
   }
   if (f119() != nullptr) {
-    _bb.writeVarUint(120);
-    _bb.writeVarInt(_data_f119);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f119);
   }
   if (f120() != nullptr) {
-    _bb.writeVarUint(121);
-    _bb.writeVarInt(_data_f120);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f120);
   }
   if (f121() != nullptr) {
-    _bb.writeVarUint(122);
-    _bb.writeVarInt(_data_f121);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f121);
   }
   if (f122() != nullptr) {
-    _bb.writeVarUint(123);
-    _bb.writeVarInt(_data_f122);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f122);
   }
   if (f123() != nullptr) {
-    _bb.writeVarUint(124);
-    _bb.writeVarInt(_data_f123);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f123);
   }
   if (f124() != nullptr) {
-    _bb.writeVarUint(125);
-    _bb.writeVarInt(_data_f124);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f124);
   }
   if (f125() != nullptr) {
-    _bb.writeVarUint(126);
-    _bb.writeVarInt(_data_f125);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f125);
   }
   if (f126() != nullptr) {
-    _bb.writeVarUint(127);
-    _bb.writeVarInt(_data_f126);
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_f126);
   }
   if (f127() != nullptr) {
-    _bb.writeVarUint(128);
-    _bb.writeVarInt(_data_f127);
+    _size += 2 + kiwi::ByteBuffer::varIntSize(_data_f127);
   }
   if (f128() != nullptr) {
-    _bb.writeVarUint(129);
-    _bb.writeVarInt(_data_f128);
+    _size += 2 + kiwi::ByteBuffer::varIntSize(_data_f128);
   }
   if (f129() != nullptr) {
-    _bb.writeVarUint(130);
-    _bb.writeVarInt(_data_f129);
+    _size += 2 + kiwi::ByteBuffer::varIntSize(_data_f129);
   }
-  _bb.writeVarUint(0);
-  return true;
+  return _size;
 }
 
-bool Message::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+bool Message::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   while (true) {
     uint32_t _type;
     if (!_bb.readVarUint(_type)) return false;
@@ -9,6 +9,11 @@ class BinarySchema {
 public:
   bool parse(kiwi::ByteBuffer &bb);
   const kiwi::BinarySchema &underlyingSchema() const { return _schema; }
+
+  // Whether all or one of the definitions compiled in here are exactly the same in the parsed schema
+  bool isIdentical() const { return _isIdentical; }
+  bool isIdentical(const char *definition) const;
+
   bool skipBoolMessageField(kiwi::ByteBuffer &bb, uint32_t id) const;
   bool skipByteMessageField(kiwi::ByteBuffer &bb, uint32_t id) const;
   bool skipIntMessageField(kiwi::ByteBuffer &bb, uint32_t id) const;
@@ -34,6 +39,8 @@ public:
 
 private:
   kiwi::BinarySchema _schema;
+  bool _isIdentical = false;
+  bool _identical[46] = {};
   uint32_t _indexBoolMessage = 0;
   uint32_t _indexByteMessage = 0;
   uint32_t _indexIntMessage = 0;
@@ -106,6 +113,8 @@ class RecursiveMessage;
 class NonDeprecatedMessage;
 class DeprecatedMessage;
 class SortedStruct;
+class StringPairStruct;
+class StringPairArrayStruct;
 
 class EnumStruct {
 public:
@@ -120,7 +129,9 @@ public:
   kiwi::Array<Enum> &set_y(kiwi::MemoryPool &pool, uint32_t count);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -137,7 +148,9 @@ public:
   void set_x(const bool &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -153,7 +166,9 @@ public:
   void set_x(const uint8_t &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -169,7 +184,9 @@ public:
   void set_x(const int32_t &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -185,7 +202,9 @@ public:
   void set_x(const uint32_t &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -201,7 +220,9 @@ public:
   void set_x(const int64_t &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -217,7 +238,9 @@ public:
   void set_x(const uint64_t &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -233,7 +256,9 @@ public:
   void set_x(const float &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -249,7 +274,9 @@ public:
   void set_x(const kiwi::String &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -269,7 +296,9 @@ public:
   void set_y(const uint32_t &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -294,7 +323,9 @@ public:
   void set_c(const uint32_t &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -312,7 +343,9 @@ public:
   void set_x(const bool &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -328,7 +361,9 @@ public:
   void set_x(const uint8_t &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -344,7 +379,9 @@ public:
   void set_x(const int32_t &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -360,7 +397,9 @@ public:
   void set_x(const uint32_t &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -376,7 +415,9 @@ public:
   void set_x(const int64_t &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -392,7 +433,9 @@ public:
   void set_x(const uint64_t &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -408,7 +451,9 @@ public:
   void set_x(const float &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -424,7 +469,9 @@ public:
   void set_x(const kiwi::String &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -444,7 +491,9 @@ public:
   void set_y(const uint32_t &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -469,7 +518,9 @@ public:
   void set_c(const uint32_t &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -487,7 +538,9 @@ public:
   kiwi::Array<bool> &set_x(kiwi::MemoryPool &pool, uint32_t count);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -503,7 +556,9 @@ public:
   kiwi::Array<uint8_t> &set_x(kiwi::MemoryPool &pool, uint32_t count);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -519,7 +574,9 @@ public:
   kiwi::Array<int32_t> &set_x(kiwi::MemoryPool &pool, uint32_t count);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -535,7 +592,9 @@ public:
   kiwi::Array<uint32_t> &set_x(kiwi::MemoryPool &pool, uint32_t count);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -551,7 +610,9 @@ public:
   kiwi::Array<int64_t> &set_x(kiwi::MemoryPool &pool, uint32_t count);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -567,7 +628,9 @@ public:
   kiwi::Array<uint64_t> &set_x(kiwi::MemoryPool &pool, uint32_t count);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -583,7 +646,9 @@ public:
   kiwi::Array<float> &set_x(kiwi::MemoryPool &pool, uint32_t count);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -599,7 +664,9 @@ public:
   kiwi::Array<kiwi::String> &set_x(kiwi::MemoryPool &pool, uint32_t count);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -619,7 +686,9 @@ public:
   kiwi::Array<uint32_t> &set_y(kiwi::MemoryPool &pool, uint32_t count);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -636,7 +705,9 @@ public:
   kiwi::Array<bool> &set_x(kiwi::MemoryPool &pool, uint32_t count);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -652,7 +723,9 @@ public:
   kiwi::Array<uint8_t> &set_x(kiwi::MemoryPool &pool, uint32_t count);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -668,7 +741,9 @@ public:
   kiwi::Array<int32_t> &set_x(kiwi::MemoryPool &pool, uint32_t count);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -684,7 +759,9 @@ public:
   kiwi::Array<uint32_t> &set_x(kiwi::MemoryPool &pool, uint32_t count);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -700,7 +777,9 @@ public:
   kiwi::Array<int64_t> &set_x(kiwi::MemoryPool &pool, uint32_t count);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -716,7 +795,9 @@ public:
   kiwi::Array<uint64_t> &set_x(kiwi::MemoryPool &pool, uint32_t count);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -732,7 +813,9 @@ public:
   kiwi::Array<float> &set_x(kiwi::MemoryPool &pool, uint32_t count);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -748,7 +831,9 @@ public:
   kiwi::Array<kiwi::String> &set_x(kiwi::MemoryPool &pool, uint32_t count);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -768,7 +853,9 @@ public:
   kiwi::Array<uint32_t> &set_y(kiwi::MemoryPool &pool, uint32_t count);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -785,7 +872,9 @@ public:
   void set_x(RecursiveMessage *value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -825,7 +914,9 @@ public:
   void set_g(const uint32_t &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -859,7 +950,9 @@ public:
   void set_g(const uint32_t &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -970,7 +1063,9 @@ public:
   kiwi::Array<uint64_t> &set_h3(kiwi::MemoryPool &pool, uint32_t count);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -1000,9 +1095,104 @@ private:
   uint8_t _data_b2 = {};
 };
 
+class StringPairStruct {
+public:
+  StringPairStruct() { (void)_flags; }
+
+  kiwi::String *a();
+  const kiwi::String *a() const;
+  void set_a(const kiwi::String &value);
+
+  kiwi::String *b();
+  const kiwi::String *b() const;
+  void set_b(const kiwi::String &value);
+
+  uint32_t *c();
+  const uint32_t *c() const;
+  void set_c(const uint32_t &value);
+
+  bool encode(kiwi::ByteBuffer &bb);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
+
+private:
+  uint32_t _flags[1] = {};
+  kiwi::String _data_a = {};
+  kiwi::String _data_b = {};
+  uint32_t _data_c = {};
+};
+
+class StringPairArrayStruct {
+public:
+  StringPairArrayStruct() { (void)_flags; }
+
+  kiwi::Array<StringPairStruct> *x();
+  const kiwi::Array<StringPairStruct> *x() const;
+  kiwi::Array<StringPairStruct> &set_x(kiwi::MemoryPool &pool, uint32_t count);
+
+  bool encode(kiwi::ByteBuffer &bb);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
+
+private:
+  uint32_t _flags[1] = {};
+  kiwi::Array<StringPairStruct> _data_x = {};
+};
+
 #endif
 #ifdef IMPLEMENT_SCHEMA_H
 
+static const struct { const char *name; uint32_t hash; } _definitionHashes[] = {
+  {"Enum", 26339333u},
+  {"EnumStruct", 1983190665u},
+  {"BoolStruct", 1638692465u},
+  {"ByteStruct", 2834886505u},
+  {"IntStruct", 299658743u},
+  {"UintStruct", 1147400853u},
+  {"Int64Struct", 2380502023u},
+  {"Uint64Struct", 866805073u},
+  {"FloatStruct", 2220702151u},
+  {"StringStruct", 2807116547u},
+  {"CompoundStruct", 4287925686u},
+  {"NestedStruct", 2146714309u},
+  {"BoolMessage", 93812776u},
+  {"ByteMessage", 318697288u},
+  {"IntMessage", 1414635134u},
+  {"UintMessage", 3091772920u},
+  {"Int64Message", 3637277482u},
+  {"Uint64Message", 2076789904u},
+  {"FloatMessage", 496545184u},
+  {"StringMessage", 1235487556u},
+  {"CompoundMessage", 635533679u},
+  {"NestedMessage", 1992419954u},
+  {"BoolArrayStruct", 3787170307u},
+  {"ByteArrayStruct", 3137683983u},
+  {"IntArrayStruct", 3892289849u},
+  {"UintArrayStruct", 2974359531u},
+  {"Int64ArrayStruct", 2367684373u},
+  {"Uint64ArrayStruct", 1364464123u},
+  {"FloatArrayStruct", 3935978483u},
+  {"StringArrayStruct", 947844451u},
+  {"CompoundArrayStruct", 1892672823u},
+  {"BoolArrayMessage", 1417691628u},
+  {"ByteArrayMessage", 2640373408u},
+  {"IntArrayMessage", 2819292758u},
+  {"UintArrayMessage", 352483880u},
+  {"Int64ArrayMessage", 1302828714u},
+  {"Uint64ArrayMessage", 2922906416u},
+  {"FloatArrayMessage", 116091106u},
+  {"StringArrayMessage", 1013032894u},
+  {"CompoundArrayMessage", 4120266348u},
+  {"RecursiveMessage", 3600447031u},
+  {"NonDeprecatedMessage", 2014716431u},
+  {"DeprecatedMessage", 3981857220u},
+  {"SortedStruct", 2863850239u},
+  {"StringPairStruct", 806379117u},
+  {"StringPairArrayStruct", 2720498508u},
+};
+
 bool BinarySchema::parse(kiwi::ByteBuffer &bb) {
   if (!_schema.parse(bb)) return false;
   _schema.findDefinition("BoolMessage", _indexBoolMessage);
@@ -1027,9 +1217,23 @@ bool BinarySchema::parse(kiwi::ByteBuffer &bb) {
   _schema.findDefinition("RecursiveMessage", _indexRecursiveMessage);
   _schema.findDefinition("NonDeprecatedMessage", _indexNonDeprecatedMessage);
   _schema.findDefinition("DeprecatedMessage", _indexDeprecatedMessage);
+  _isIdentical = true;
+  for (uint32_t i = 0; i < 46; i++) {
+    uint32_t index, hash;
+    _identical[i] = _schema.findDefinition(_definitionHashes[i].name, index) &&
+      _schema.definitionHash(index, hash) && hash == _definitionHashes[i].hash;
+    _isIdentical = _isIdentical && _identical[i];
+  }
   return true;
 }
 
+bool BinarySchema::isIdentical(const char *definition) const {
+  for (uint32_t i = 0; i < 46; i++) {
+    if (!strcmp(_definitionHashes[i].name, definition)) return _identical[i];
+  }
+  return false;
+}
+
 bool BinarySchema::skipBoolMessageField(kiwi::ByteBuffer &bb, uint32_t id) const {
   return _schema.skipField(bb, _indexBoolMessage, id);
 }
@@ -1143,20 +1347,41 @@ kiwi::Array<Enum> &EnumStruct::set_y(kiwi::MemoryPool &pool, uint32_t count) {
 }
 
 bool EnumStruct::encode(kiwi::ByteBuffer &_bb) {
+  uint8_t *_out;
   if (x() == nullptr) return false;
   _bb.writeVarUint(static_cast<uint32_t>(_data_x));
   if (y() == nullptr) return false;
   _bb.writeVarUint(_data_y.size());
-  for (Enum &_it : _data_y) _bb.writeVarUint(static_cast<uint32_t>(_it));
+  for (const Enum *_p = _data_y.begin(), *_end = _data_y.end(); _p != _end;) {
+    size_t _count = _bb.writeBatchSize(_end - _p, 5);
+    if (_count == 0) { const Enum &_it = *_p++; _bb.writeVarUint(static_cast<uint32_t>(_it)); continue; }
+    _out = _bb.beginWrite(5 * _count);
+    for (const Enum *_batch = _p + _count; _p != _batch; _p++) { const Enum &_it = *_p; kiwi::ByteBuffer::putVarUint(_out, static_cast<uint32_t>(_it)); }
+    _bb.endWrite(_out);
+  }
   return true;
 }
 
-bool EnumStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t EnumStruct::encodedSize() const {
+  size_t _size = 0;
+  if (x() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(static_cast<uint32_t>(_data_x));
+  }
+  if (y() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_y.size());
+    for (const Enum &_it : _data_y) _size += kiwi::ByteBuffer::varUintSize(static_cast<uint32_t>(_it));
+  }
+  return _size;
+}
+
+bool EnumStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   uint32_t _count;
   if (!_bb.readVarUint(reinterpret_cast<uint32_t &>(_data_x))) return false;
   set_x(_data_x);
   if (!_bb.readVarUint(_count)) return false;
-  for (Enum &_it : set_y(_pool, _count)) if (!_bb.readVarUint(reinterpret_cast<uint32_t &>(_it))) return false;
+  kiwi::Array<Enum> _y_array = _pool.arrayUninitialized<Enum>(_count);
+  if (!_bb.readVarUintArray(reinterpret_cast<uint32_t *>(_y_array.data()), _count)) return false;
+  _flags[0] |= 2; _data_y = _y_array;
   return true;
 }
 
@@ -1174,11 +1399,25 @@ void BoolStruct::set_x(const bool &value) {
 
 bool BoolStruct::encode(kiwi::ByteBuffer &_bb) {
   if (x() == nullptr) return false;
+  if (_bb.writeBatchSize(1, 1)) {
+    uint8_t *_out = _bb.beginWrite(1);
+    kiwi::ByteBuffer::putByte(_out, _data_x);
+    _bb.endWrite(_out);
+    return true;
+  }
   _bb.writeByte(_data_x);
   return true;
 }
 
-bool BoolStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t BoolStruct::encodedSize() const {
+  size_t _size = 0;
+  if (x() != nullptr) {
+    _size += 1;
+  }
+  return _size;
+}
+
+bool BoolStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   if (!_bb.readByte(_data_x)) return false;
   set_x(_data_x);
   return true;
@@ -1198,11 +1437,25 @@ void ByteStruct::set_x(const uint8_t &value) {
 
 bool ByteStruct::encode(kiwi::ByteBuffer &_bb) {
   if (x() == nullptr) return false;
+  if (_bb.writeBatchSize(1, 1)) {
+    uint8_t *_out = _bb.beginWrite(1);
+    kiwi::ByteBuffer::putByte(_out, _data_x);
+    _bb.endWrite(_out);
+    return true;
+  }
   _bb.writeByte(_data_x);
   return true;
 }
 
-bool ByteStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t ByteStruct::encodedSize() const {
+  size_t _size = 0;
+  if (x() != nullptr) {
+    _size += 1;
+  }
+  return _size;
+}
+
+bool ByteStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   if (!_bb.readByte(_data_x)) return false;
   set_x(_data_x);
   return true;
@@ -1222,11 +1475,25 @@ void IntStruct::set_x(const int32_t &value) {
 
 bool IntStruct::encode(kiwi::ByteBuffer &_bb) {
   if (x() == nullptr) return false;
+  if (_bb.writeBatchSize(1, 5)) {
+    uint8_t *_out = _bb.beginWrite(5);
+    kiwi::ByteBuffer::putVarInt(_out, _data_x);
+    _bb.endWrite(_out);
+    return true;
+  }
   _bb.writeVarInt(_data_x);
   return true;
 }
 
-bool IntStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t IntStruct::encodedSize() const {
+  size_t _size = 0;
+  if (x() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_x);
+  }
+  return _size;
+}
+
+bool IntStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   if (!_bb.readVarInt(_data_x)) return false;
   set_x(_data_x);
   return true;
@@ -1246,11 +1513,25 @@ void UintStruct::set_x(const uint32_t &value) {
 
 bool UintStruct::encode(kiwi::ByteBuffer &_bb) {
   if (x() == nullptr) return false;
+  if (_bb.writeBatchSize(1, 5)) {
+    uint8_t *_out = _bb.beginWrite(5);
+    kiwi::ByteBuffer::putVarUint(_out, _data_x);
+    _bb.endWrite(_out);
+    return true;
+  }
   _bb.writeVarUint(_data_x);
   return true;
 }
 
-bool UintStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t UintStruct::encodedSize() const {
+  size_t _size = 0;
+  if (x() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_x);
+  }
+  return _size;
+}
+
+bool UintStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   if (!_bb.readVarUint(_data_x)) return false;
   set_x(_data_x);
   return true;
@@ -1270,11 +1551,25 @@ void Int64Struct::set_x(const int64_t &value) {
 
 bool Int64Struct::encode(kiwi::ByteBuffer &_bb) {
   if (x() == nullptr) return false;
+  if (_bb.writeBatchSize(1, 9)) {
+    uint8_t *_out = _bb.beginWrite(9);
+    kiwi::ByteBuffer::putVarInt64(_out, _data_x);
+    _bb.endWrite(_out);
+    return true;
+  }
   _bb.writeVarInt64(_data_x);
   return true;
 }
 
-bool Int64Struct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t Int64Struct::encodedSize() const {
+  size_t _size = 0;
+  if (x() != nullptr) {
+    _size += kiwi::ByteBuffer::varInt64Size(_data_x);
+  }
+  return _size;
+}
+
+bool Int64Struct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   if (!_bb.readVarInt64(_data_x)) return false;
   set_x(_data_x);
   return true;
@@ -1294,11 +1589,25 @@ void Uint64Struct::set_x(const uint64_t &value) {
 
 bool Uint64Struct::encode(kiwi::ByteBuffer &_bb) {
   if (x() == nullptr) return false;
+  if (_bb.writeBatchSize(1, 9)) {
+    uint8_t *_out = _bb.beginWrite(9);
+    kiwi::ByteBuffer::putVarUint64(_out, _data_x);
+    _bb.endWrite(_out);
+    return true;
+  }
   _bb.writeVarUint64(_data_x);
   return true;
 }
 
-bool Uint64Struct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t Uint64Struct::encodedSize() const {
+  size_t _size = 0;
+  if (x() != nullptr) {
+    _size += kiwi::ByteBuffer::varUint64Size(_data_x);
+  }
+  return _size;
+}
+
+bool Uint64Struct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   if (!_bb.readVarUint64(_data_x)) return false;
   set_x(_data_x);
   return true;
@@ -1318,11 +1627,25 @@ void FloatStruct::set_x(const float &value) {
 
 bool FloatStruct::encode(kiwi::ByteBuffer &_bb) {
   if (x() == nullptr) return false;
+  if (_bb.writeBatchSize(1, 4)) {
+    uint8_t *_out = _bb.beginWrite(4);
+    kiwi::ByteBuffer::putVarFloat(_out, _data_x);
+    _bb.endWrite(_out);
+    return true;
+  }
   _bb.writeVarFloat(_data_x);
   return true;
 }
 
-bool FloatStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t FloatStruct::encodedSize() const {
+  size_t _size = 0;
+  if (x() != nullptr) {
+    _size += kiwi::ByteBuffer::varFloatSize(_data_x);
+  }
+  return _size;
+}
+
+bool FloatStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   if (!_bb.readVarFloat(_data_x)) return false;
   set_x(_data_x);
   return true;
@@ -1342,12 +1665,20 @@ void StringStruct::set_x(const kiwi::String &value) {
 
 bool StringStruct::encode(kiwi::ByteBuffer &_bb) {
   if (x() == nullptr) return false;
-  _bb.writeString(_data_x.c_str());
+  _bb.writeString(_data_x);
   return true;
 }
 
-bool StringStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
-  if (!_bb.readString(_data_x, _pool)) return false;
+size_t StringStruct::encodedSize() const {
+  size_t _size = 0;
+  if (x() != nullptr) {
+    _size += (_data_x.size() + 1);
+  }
+  return _size;
+}
+
+bool StringStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
+  if (!(_borrow ? _bb.readBorrowedString(_data_x) : _bb.readString(_data_x, _pool))) return false;
   set_x(_data_x);
   return true;
 }
@@ -1378,13 +1709,31 @@ void CompoundStruct::set_y(const uint32_t &value) {
 
 bool CompoundStruct::encode(kiwi::ByteBuffer &_bb) {
   if (x() == nullptr) return false;
-  _bb.writeVarUint(_data_x);
   if (y() == nullptr) return false;
+  if (_bb.writeBatchSize(1, 10)) {
+    uint8_t *_out = _bb.beginWrite(10);
+    kiwi::ByteBuffer::putVarUint(_out, _data_x);
+    kiwi::ByteBuffer::putVarUint(_out, _data_y);
+    _bb.endWrite(_out);
+    return true;
+  }
+  _bb.writeVarUint(_data_x);
   _bb.writeVarUint(_data_y);
   return true;
 }
 
-bool CompoundStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t CompoundStruct::encodedSize() const {
+  size_t _size = 0;
+  if (x() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_x);
+  }
+  if (y() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_y);
+  }
+  return _size;
+}
+
+bool CompoundStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   if (!_bb.readVarUint(_data_x)) return false;
   set_x(_data_x);
   if (!_bb.readVarUint(_data_y)) return false;
@@ -1438,11 +1787,25 @@ bool NestedStruct::encode(kiwi::ByteBuffer &_bb) {
   return true;
 }
 
-bool NestedStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t NestedStruct::encodedSize() const {
+  size_t _size = 0;
+  if (a() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_a);
+  }
+  if (b() != nullptr) {
+    _size += _data_b->encodedSize();
+  }
+  if (c() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_c);
+  }
+  return _size;
+}
+
+bool NestedStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   if (!_bb.readVarUint(_data_a)) return false;
   set_a(_data_a);
   _data_b = _pool.allocate<CompoundStruct>();
-  if (!_data_b->decode(_bb, _pool, _schema)) return false;
+  if (!_data_b->decode(_bb, _pool, _schema, _borrow)) return false;
   if (!_bb.readVarUint(_data_c)) return false;
   set_c(_data_c);
   return true;
@@ -1469,7 +1832,15 @@ bool BoolMessage::encode(kiwi::ByteBuffer &_bb) {
   return true;
 }
 
-bool BoolMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t BoolMessage::encodedSize() const {
+  size_t _size = 1;
+  if (x() != nullptr) {
+    _size += 1 + 1;
+  }
+  return _size;
+}
+
+bool BoolMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   while (true) {
     uint32_t _type;
     if (!_bb.readVarUint(_type)) return false;
@@ -1510,7 +1881,15 @@ bool ByteMessage::encode(kiwi::ByteBuffer &_bb) {
   return true;
 }
 
-bool ByteMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t ByteMessage::encodedSize() const {
+  size_t _size = 1;
+  if (x() != nullptr) {
+    _size += 1 + 1;
+  }
+  return _size;
+}
+
+bool ByteMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   while (true) {
     uint32_t _type;
     if (!_bb.readVarUint(_type)) return false;
@@ -1551,7 +1930,15 @@ bool IntMessage::encode(kiwi::ByteBuffer &_bb) {
   return true;
 }
 
-bool IntMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t IntMessage::encodedSize() const {
+  size_t _size = 1;
+  if (x() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_x);
+  }
+  return _size;
+}
+
+bool IntMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   while (true) {
     uint32_t _type;
     if (!_bb.readVarUint(_type)) return false;
@@ -1592,7 +1979,15 @@ bool UintMessage::encode(kiwi::ByteBuffer &_bb) {
   return true;
 }
 
-bool UintMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t UintMessage::encodedSize() const {
+  size_t _size = 1;
+  if (x() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varUintSize(_data_x);
+  }
+  return _size;
+}
+
+bool UintMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   while (true) {
     uint32_t _type;
     if (!_bb.readVarUint(_type)) return false;
@@ -1633,7 +2028,15 @@ bool Int64Message::encode(kiwi::ByteBuffer &_bb) {
   return true;
 }
 
-bool Int64Message::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t Int64Message::encodedSize() const {
+  size_t _size = 1;
+  if (x() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varInt64Size(_data_x);
+  }
+  return _size;
+}
+
+bool Int64Message::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   while (true) {
     uint32_t _type;
     if (!_bb.readVarUint(_type)) return false;
@@ -1674,7 +2077,15 @@ bool Uint64Message::encode(kiwi::ByteBuffer &_bb) {
   return true;
 }
 
-bool Uint64Message::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t Uint64Message::encodedSize() const {
+  size_t _size = 1;
+  if (x() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varUint64Size(_data_x);
+  }
+  return _size;
+}
+
+bool Uint64Message::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   while (true) {
     uint32_t _type;
     if (!_bb.readVarUint(_type)) return false;
@@ -1715,7 +2126,15 @@ bool FloatMessage::encode(kiwi::ByteBuffer &_bb) {
   return true;
 }
 
-bool FloatMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t FloatMessage::encodedSize() const {
+  size_t _size = 1;
+  if (x() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varFloatSize(_data_x);
+  }
+  return _size;
+}
+
+bool FloatMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   while (true) {
     uint32_t _type;
     if (!_bb.readVarUint(_type)) return false;
@@ -1750,13 +2169,21 @@ void StringMessage::set_x(const kiwi::String &value) {
 bool StringMessage::encode(kiwi::ByteBuffer &_bb) {
   if (x() != nullptr) {
     _bb.writeVarUint(1);
-    _bb.writeString(_data_x.c_str());
+    _bb.writeString(_data_x);
   }
   _bb.writeVarUint(0);
   return true;
 }
 
-bool StringMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t StringMessage::encodedSize() const {
+  size_t _size = 1;
+  if (x() != nullptr) {
+    _size += 1 + (_data_x.size() + 1);
+  }
+  return _size;
+}
+
+bool StringMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   while (true) {
     uint32_t _type;
     if (!_bb.readVarUint(_type)) return false;
@@ -1764,7 +2191,7 @@ bool StringMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const
       case 0:
         return true;
       case 1: {
-        if (!_bb.readString(_data_x, _pool)) return false;
+        if (!(_borrow ? _bb.readBorrowedString(_data_x) : _bb.readString(_data_x, _pool))) return false;
         set_x(_data_x);
         break;
       }
@@ -1813,7 +2240,18 @@ bool CompoundMessage::encode(kiwi::ByteBuffer &_bb) {
   return true;
 }
 
-bool CompoundMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t CompoundMessage::encodedSize() const {
+  size_t _size = 1;
+  if (x() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varUintSize(_data_x);
+  }
+  if (y() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varUintSize(_data_y);
+  }
+  return _size;
+}
+
+bool CompoundMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   while (true) {
     uint32_t _type;
     if (!_bb.readVarUint(_type)) return false;
@@ -1891,7 +2329,21 @@ bool NestedMessage::encode(kiwi::ByteBuffer &_bb) {
   return true;
 }
 
-bool NestedMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t NestedMessage::encodedSize() const {
+  size_t _size = 1;
+  if (a() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varUintSize(_data_a);
+  }
+  if (b() != nullptr) {
+    _size += 1 + _data_b->encodedSize();
+  }
+  if (c() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varUintSize(_data_c);
+  }
+  return _size;
+}
+
+bool NestedMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   while (true) {
     uint32_t _type;
     if (!_bb.readVarUint(_type)) return false;
@@ -1905,7 +2357,7 @@ bool NestedMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const
       }
       case 2: {
         _data_b = _pool.allocate<CompoundMessage>();
-        if (!_data_b->decode(_bb, _pool, _schema)) return false;
+        if (!_data_b->decode(_bb, _pool, _schema, _borrow)) return false;
         break;
       }
       case 3: {
@@ -1934,16 +2386,33 @@ kiwi::Array<bool> &BoolArrayStruct::set_x(kiwi::MemoryPool &pool, uint32_t count
 }
 
 bool BoolArrayStruct::encode(kiwi::ByteBuffer &_bb) {
+  uint8_t *_out;
   if (x() == nullptr) return false;
   _bb.writeVarUint(_data_x.size());
-  for (bool &_it : _data_x) _bb.writeByte(_it);
+  for (const bool *_p = _data_x.begin(), *_end = _data_x.end(); _p != _end;) {
+    size_t _count = _bb.writeBatchSize(_end - _p, 1);
+    if (_count == 0) { const bool &_it = *_p++; _bb.writeByte(_it); continue; }
+    _out = _bb.beginWrite(1 * _count);
+    for (const bool *_batch = _p + _count; _p != _batch; _p++) { const bool &_it = *_p; kiwi::ByteBuffer::putByte(_out, _it); }
+    _bb.endWrite(_out);
+  }
   return true;
 }
 
-bool BoolArrayStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t BoolArrayStruct::encodedSize() const {
+  size_t _size = 0;
+  if (x() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_x.size()) + _data_x.size();
+  }
+  return _size;
+}
+
+bool BoolArrayStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   uint32_t _count;
   if (!_bb.readVarUint(_count)) return false;
-  for (bool &_it : set_x(_pool, _count)) if (!_bb.readByte(_it)) return false;
+  kiwi::Array<bool> _x_array = _pool.arrayUninitialized<bool>(_count);
+  for (bool &_it : _x_array) if (!_bb.readByte(_it)) return false;
+  _flags[0] |= 1; _data_x = _x_array;
   return true;
 }
 
@@ -1962,14 +2431,23 @@ kiwi::Array<uint8_t> &ByteArrayStruct::set_x(kiwi::MemoryPool &pool, uint32_t co
 bool ByteArrayStruct::encode(kiwi::ByteBuffer &_bb) {
   if (x() == nullptr) return false;
   _bb.writeVarUint(_data_x.size());
-  for (uint8_t &_it : _data_x) _bb.writeByte(_it);
+  _bb.writeBytes(_data_x.data(), _data_x.size());
   return true;
 }
 
-bool ByteArrayStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t ByteArrayStruct::encodedSize() const {
+  size_t _size = 0;
+  if (x() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_x.size()) + _data_x.size();
+  }
+  return _size;
+}
+
+bool ByteArrayStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   uint32_t _count;
-  if (!_bb.readVarUint(_count)) return false;
-  for (uint8_t &_it : set_x(_pool, _count)) if (!_bb.readByte(_it)) return false;
+  const uint8_t *_bytes;
+  if (!_bb.readVarUint(_count) || !(_borrow ? _bb.readBorrowedBytes(_bytes, _count) : _bb.readBytes(_bytes, _count))) return false;
+  _flags[0] |= 1; _data_x = _borrow ? kiwi::Array<uint8_t>(const_cast<uint8_t *>(_bytes), _count) : _pool.array(_bytes, _count);
   return true;
 }
 
@@ -1986,16 +2464,34 @@ kiwi::Array<int32_t> &IntArrayStruct::set_x(kiwi::MemoryPool &pool, uint32_t cou
 }
 
 bool IntArrayStruct::encode(kiwi::ByteBuffer &_bb) {
+  uint8_t *_out;
   if (x() == nullptr) return false;
   _bb.writeVarUint(_data_x.size());
-  for (int32_t &_it : _data_x) _bb.writeVarInt(_it);
+  for (const int32_t *_p = _data_x.begin(), *_end = _data_x.end(); _p != _end;) {
+    size_t _count = _bb.writeBatchSize(_end - _p, 5);
+    if (_count == 0) { const int32_t &_it = *_p++; _bb.writeVarInt(_it); continue; }
+    _out = _bb.beginWrite(5 * _count);
+    for (const int32_t *_batch = _p + _count; _p != _batch; _p++) { const int32_t &_it = *_p; kiwi::ByteBuffer::putVarInt(_out, _it); }
+    _bb.endWrite(_out);
+  }
   return true;
 }
 
-bool IntArrayStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t IntArrayStruct::encodedSize() const {
+  size_t _size = 0;
+  if (x() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_x.size());
+    for (const int32_t &_it : _data_x) _size += kiwi::ByteBuffer::varIntSize(_it);
+  }
+  return _size;
+}
+
+bool IntArrayStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   uint32_t _count;
   if (!_bb.readVarUint(_count)) return false;
-  for (int32_t &_it : set_x(_pool, _count)) if (!_bb.readVarInt(_it)) return false;
+  kiwi::Array<int32_t> _x_array = _pool.arrayUninitialized<int32_t>(_count);
+  if (!_bb.readVarIntArray(_x_array.data(), _count)) return false;
+  _flags[0] |= 1; _data_x = _x_array;
   return true;
 }
 
@@ -2012,16 +2508,34 @@ kiwi::Array<uint32_t> &UintArrayStruct::set_x(kiwi::MemoryPool &pool, uint32_t c
 }
 
 bool UintArrayStruct::encode(kiwi::ByteBuffer &_bb) {
+  uint8_t *_out;
   if (x() == nullptr) return false;
   _bb.writeVarUint(_data_x.size());
-  for (uint32_t &_it : _data_x) _bb.writeVarUint(_it);
+  for (const uint32_t *_p = _data_x.begin(), *_end = _data_x.end(); _p != _end;) {
+    size_t _count = _bb.writeBatchSize(_end - _p, 5);
+    if (_count == 0) { const uint32_t &_it = *_p++; _bb.writeVarUint(_it); continue; }
+    _out = _bb.beginWrite(5 * _count);
+    for (const uint32_t *_batch = _p + _count; _p != _batch; _p++) { const uint32_t &_it = *_p; kiwi::ByteBuffer::putVarUint(_out, _it); }
+    _bb.endWrite(_out);
+  }
   return true;
 }
 
-bool UintArrayStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t UintArrayStruct::encodedSize() const {
+  size_t _size = 0;
+  if (x() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_x.size());
+    for (const uint32_t &_it : _data_x) _size += kiwi::ByteBuffer::varUintSize(_it);
+  }
+  return _size;
+}
+
+bool UintArrayStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   uint32_t _count;
   if (!_bb.readVarUint(_count)) return false;
-  for (uint32_t &_it : set_x(_pool, _count)) if (!_bb.readVarUint(_it)) return false;
+  kiwi::Array<uint32_t> _x_array = _pool.arrayUninitialized<uint32_t>(_count);
+  if (!_bb.readVarUintArray(_x_array.data(), _count)) return false;
+  _flags[0] |= 1; _data_x = _x_array;
   return true;
 }
 
@@ -2038,16 +2552,34 @@ kiwi::Array<int64_t> &Int64ArrayStruct::set_x(kiwi::MemoryPool &pool, uint32_t c
 }
 
 bool Int64ArrayStruct::encode(kiwi::ByteBuffer &_bb) {
+  uint8_t *_out;
   if (x() == nullptr) return false;
   _bb.writeVarUint(_data_x.size());
-  for (int64_t &_it : _data_x) _bb.writeVarInt64(_it);
+  for (const int64_t *_p = _data_x.begin(), *_end = _data_x.end(); _p != _end;) {
+    size_t _count = _bb.writeBatchSize(_end - _p, 9);
+    if (_count == 0) { const int64_t &_it = *_p++; _bb.writeVarInt64(_it); continue; }
+    _out = _bb.beginWrite(9 * _count);
+    for (const int64_t *_batch = _p + _count; _p != _batch; _p++) { const int64_t &_it = *_p; kiwi::ByteBuffer::putVarInt64(_out, _it); }
+    _bb.endWrite(_out);
+  }
   return true;
 }
 
-bool Int64ArrayStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t Int64ArrayStruct::encodedSize() const {
+  size_t _size = 0;
+  if (x() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_x.size());
+    for (const int64_t &_it : _data_x) _size += kiwi::ByteBuffer::varInt64Size(_it);
+  }
+  return _size;
+}
+
+bool Int64ArrayStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   uint32_t _count;
   if (!_bb.readVarUint(_count)) return false;
-  for (int64_t &_it : set_x(_pool, _count)) if (!_bb.readVarInt64(_it)) return false;
+  kiwi::Array<int64_t> _x_array = _pool.arrayUninitialized<int64_t>(_count);
+  for (int64_t &_it : _x_array) if (!_bb.readVarInt64(_it)) return false;
+  _flags[0] |= 1; _data_x = _x_array;
   return true;
 }
 
@@ -2064,16 +2596,34 @@ kiwi::Array<uint64_t> &Uint64ArrayStruct::set_x(kiwi::MemoryPool &pool, uint32_t
 }
 
 bool Uint64ArrayStruct::encode(kiwi::ByteBuffer &_bb) {
+  uint8_t *_out;
   if (x() == nullptr) return false;
   _bb.writeVarUint(_data_x.size());
-  for (uint64_t &_it : _data_x) _bb.writeVarUint64(_it);
+  for (const uint64_t *_p = _data_x.begin(), *_end = _data_x.end(); _p != _end;) {
+    size_t _count = _bb.writeBatchSize(_end - _p, 9);
+    if (_count == 0) { const uint64_t &_it = *_p++; _bb.writeVarUint64(_it); continue; }
+    _out = _bb.beginWrite(9 * _count);
+    for (const uint64_t *_batch = _p + _count; _p != _batch; _p++) { const uint64_t &_it = *_p; kiwi::ByteBuffer::putVarUint64(_out, _it); }
+    _bb.endWrite(_out);
+  }
   return true;
 }
 
-bool Uint64ArrayStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t Uint64ArrayStruct::encodedSize() const {
+  size_t _size = 0;
+  if (x() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_x.size());
+    for (const uint64_t &_it : _data_x) _size += kiwi::ByteBuffer::varUint64Size(_it);
+  }
+  return _size;
+}
+
+bool Uint64ArrayStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   uint32_t _count;
   if (!_bb.readVarUint(_count)) return false;
-  for (uint64_t &_it : set_x(_pool, _count)) if (!_bb.readVarUint64(_it)) return false;
+  kiwi::Array<uint64_t> _x_array = _pool.arrayUninitialized<uint64_t>(_count);
+  for (uint64_t &_it : _x_array) if (!_bb.readVarUint64(_it)) return false;
+  _flags[0] |= 1; _data_x = _x_array;
   return true;
 }
 
@@ -2090,16 +2640,34 @@ kiwi::Array<float> &FloatArrayStruct::set_x(kiwi::MemoryPool &pool, uint32_t cou
 }
 
 bool FloatArrayStruct::encode(kiwi::ByteBuffer &_bb) {
+  uint8_t *_out;
   if (x() == nullptr) return false;
   _bb.writeVarUint(_data_x.size());
-  for (float &_it : _data_x) _bb.writeVarFloat(_it);
+  for (const float *_p = _data_x.begin(), *_end = _data_x.end(); _p != _end;) {
+    size_t _count = _bb.writeBatchSize(_end - _p, 4);
+    if (_count == 0) { const float &_it = *_p++; _bb.writeVarFloat(_it); continue; }
+    _out = _bb.beginWrite(4 * _count);
+    for (const float *_batch = _p + _count; _p != _batch; _p++) { const float &_it = *_p; kiwi::ByteBuffer::putVarFloat(_out, _it); }
+    _bb.endWrite(_out);
+  }
   return true;
 }
 
-bool FloatArrayStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t FloatArrayStruct::encodedSize() const {
+  size_t _size = 0;
+  if (x() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_x.size());
+    for (const float &_it : _data_x) _size += kiwi::ByteBuffer::varFloatSize(_it);
+  }
+  return _size;
+}
+
+bool FloatArrayStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   uint32_t _count;
   if (!_bb.readVarUint(_count)) return false;
-  for (float &_it : set_x(_pool, _count)) if (!_bb.readVarFloat(_it)) return false;
+  kiwi::Array<float> _x_array = _pool.arrayUninitialized<float>(_count);
+  for (float &_it : _x_array) if (!_bb.readVarFloat(_it)) return false;
+  _flags[0] |= 1; _data_x = _x_array;
   return true;
 }
 
@@ -2118,14 +2686,25 @@ kiwi::Array<kiwi::String> &StringArrayStruct::set_x(kiwi::MemoryPool &pool, uint
 bool StringArrayStruct::encode(kiwi::ByteBuffer &_bb) {
   if (x() == nullptr) return false;
   _bb.writeVarUint(_data_x.size());
-  for (kiwi::String &_it : _data_x) _bb.writeString(_it.c_str());
+  for (kiwi::String &_it : _data_x) _bb.writeString(_it);
   return true;
 }
 
-bool StringArrayStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t StringArrayStruct::encodedSize() const {
+  size_t _size = 0;
+  if (x() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_x.size());
+    for (const kiwi::String &_it : _data_x) _size += (_it.size() + 1);
+  }
+  return _size;
+}
+
+bool StringArrayStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   uint32_t _count;
   if (!_bb.readVarUint(_count)) return false;
-  for (kiwi::String &_it : set_x(_pool, _count)) if (!_bb.readString(_it, _pool)) return false;
+  kiwi::Array<kiwi::String> _x_array = _pool.array<kiwi::String>(_count);
+  for (kiwi::String &_it : _x_array) if (!(_borrow ? _bb.readBorrowedString(_it) : _bb.readString(_it, _pool))) return false;
+  _flags[0] |= 1; _data_x = _x_array;
   return true;
 }
 
@@ -2154,21 +2733,51 @@ kiwi::Array<uint32_t> &CompoundArrayStruct::set_y(kiwi::MemoryPool &pool, uint32
 }
 
 bool CompoundArrayStruct::encode(kiwi::ByteBuffer &_bb) {
+  uint8_t *_out;
   if (x() == nullptr) return false;
   _bb.writeVarUint(_data_x.size());
-  for (uint32_t &_it : _data_x) _bb.writeVarUint(_it);
+  for (const uint32_t *_p = _data_x.begin(), *_end = _data_x.end(); _p != _end;) {
+    size_t _count = _bb.writeBatchSize(_end - _p, 5);
+    if (_count == 0) { const uint32_t &_it = *_p++; _bb.writeVarUint(_it); continue; }
+    _out = _bb.beginWrite(5 * _count);
+    for (const uint32_t *_batch = _p + _count; _p != _batch; _p++) { const uint32_t &_it = *_p; kiwi::ByteBuffer::putVarUint(_out, _it); }
+    _bb.endWrite(_out);
+  }
   if (y() == nullptr) return false;
   _bb.writeVarUint(_data_y.size());
-  for (uint32_t &_it : _data_y) _bb.writeVarUint(_it);
+  for (const uint32_t *_p = _data_y.begin(), *_end = _data_y.end(); _p != _end;) {
+    size_t _count = _bb.writeBatchSize(_end - _p, 5);
+    if (_count == 0) { const uint32_t &_it = *_p++; _bb.writeVarUint(_it); continue; }
+    _out = _bb.beginWrite(5 * _count);
+    for (const uint32_t *_batch = _p + _count; _p != _batch; _p++) { const uint32_t &_it = *_p; kiwi::ByteBuffer::putVarUint(_out, _it); }
+    _bb.endWrite(_out);
+  }
   return true;
 }
 
-bool CompoundArrayStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t CompoundArrayStruct::encodedSize() const {
+  size_t _size = 0;
+  if (x() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_x.size());
+    for (const uint32_t &_it : _data_x) _size += kiwi::ByteBuffer::varUintSize(_it);
+  }
+  if (y() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_y.size());
+    for (const uint32_t &_it : _data_y) _size += kiwi::ByteBuffer::varUintSize(_it);
+  }
+  return _size;
+}
+
+bool CompoundArrayStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   uint32_t _count;
   if (!_bb.readVarUint(_count)) return false;
-  for (uint32_t &_it : set_x(_pool, _count)) if (!_bb.readVarUint(_it)) return false;
+  kiwi::Array<uint32_t> _x_array = _pool.arrayUninitialized<uint32_t>(_count);
+  if (!_bb.readVarUintArray(_x_array.data(), _count)) return false;
+  _flags[0] |= 1; _data_x = _x_array;
   if (!_bb.readVarUint(_count)) return false;
-  for (uint32_t &_it : set_y(_pool, _count)) if (!_bb.readVarUint(_it)) return false;
+  kiwi::Array<uint32_t> _y_array = _pool.arrayUninitialized<uint32_t>(_count);
+  if (!_bb.readVarUintArray(_y_array.data(), _count)) return false;
+  _flags[0] |= 2; _data_y = _y_array;
   return true;
 }
 
@@ -2185,16 +2794,31 @@ kiwi::Array<bool> &BoolArrayMessage::set_x(kiwi::MemoryPool &pool, uint32_t coun
 }
 
 bool BoolArrayMessage::encode(kiwi::ByteBuffer &_bb) {
+  uint8_t *_out;
   if (x() != nullptr) {
     _bb.writeVarUint(1);
     _bb.writeVarUint(_data_x.size());
-    for (bool &_it : _data_x) _bb.writeByte(_it);
+    for (const bool *_p = _data_x.begin(), *_end = _data_x.end(); _p != _end;) {
+      size_t _count = _bb.writeBatchSize(_end - _p, 1);
+      if (_count == 0) { const bool &_it = *_p++; _bb.writeByte(_it); continue; }
+      _out = _bb.beginWrite(1 * _count);
+      for (const bool *_batch = _p + _count; _p != _batch; _p++) { const bool &_it = *_p; kiwi::ByteBuffer::putByte(_out, _it); }
+      _bb.endWrite(_out);
+    }
   }
   _bb.writeVarUint(0);
   return true;
 }
 
-bool BoolArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t BoolArrayMessage::encodedSize() const {
+  size_t _size = 1;
+  if (x() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varUintSize(_data_x.size()) + _data_x.size();
+  }
+  return _size;
+}
+
+bool BoolArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   uint32_t _count;
   while (true) {
     uint32_t _type;
@@ -2204,7 +2828,9 @@ bool BoolArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, co
         return true;
       case 1: {
         if (!_bb.readVarUint(_count)) return false;
-        for (bool &_it : set_x(_pool, _count)) if (!_bb.readByte(_it)) return false;
+        kiwi::Array<bool> _x_array = _pool.arrayUninitialized<bool>(_count);
+        for (bool &_it : _x_array) if (!_bb.readByte(_it)) return false;
+        _flags[0] |= 1; _data_x = _x_array;
         break;
       }
       default: {
@@ -2231,14 +2857,23 @@ bool ByteArrayMessage::encode(kiwi::ByteBuffer &_bb) {
   if (x() != nullptr) {
     _bb.writeVarUint(1);
     _bb.writeVarUint(_data_x.size());
-    for (uint8_t &_it : _data_x) _bb.writeByte(_it);
+    _bb.writeBytes(_data_x.data(), _data_x.size());
   }
   _bb.writeVarUint(0);
   return true;
 }
 
-bool ByteArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t ByteArrayMessage::encodedSize() const {
+  size_t _size = 1;
+  if (x() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varUintSize(_data_x.size()) + _data_x.size();
+  }
+  return _size;
+}
+
+bool ByteArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   uint32_t _count;
+  const uint8_t *_bytes;
   while (true) {
     uint32_t _type;
     if (!_bb.readVarUint(_type)) return false;
@@ -2246,8 +2881,8 @@ bool ByteArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, co
       case 0:
         return true;
       case 1: {
-        if (!_bb.readVarUint(_count)) return false;
-        for (uint8_t &_it : set_x(_pool, _count)) if (!_bb.readByte(_it)) return false;
+        if (!_bb.readVarUint(_count) || !(_borrow ? _bb.readBorrowedBytes(_bytes, _count) : _bb.readBytes(_bytes, _count))) return false;
+        _flags[0] |= 1; _data_x = _borrow ? kiwi::Array<uint8_t>(const_cast<uint8_t *>(_bytes), _count) : _pool.array(_bytes, _count);
         break;
       }
       default: {
@@ -2271,16 +2906,32 @@ kiwi::Array<int32_t> &IntArrayMessage::set_x(kiwi::MemoryPool &pool, uint32_t co
 }
 
 bool IntArrayMessage::encode(kiwi::ByteBuffer &_bb) {
+  uint8_t *_out;
   if (x() != nullptr) {
     _bb.writeVarUint(1);
     _bb.writeVarUint(_data_x.size());
-    for (int32_t &_it : _data_x) _bb.writeVarInt(_it);
+    for (const int32_t *_p = _data_x.begin(), *_end = _data_x.end(); _p != _end;) {
+      size_t _count = _bb.writeBatchSize(_end - _p, 5);
+      if (_count == 0) { const int32_t &_it = *_p++; _bb.writeVarInt(_it); continue; }
+      _out = _bb.beginWrite(5 * _count);
+      for (const int32_t *_batch = _p + _count; _p != _batch; _p++) { const int32_t &_it = *_p; kiwi::ByteBuffer::putVarInt(_out, _it); }
+      _bb.endWrite(_out);
+    }
   }
   _bb.writeVarUint(0);
   return true;
 }
 
-bool IntArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t IntArrayMessage::encodedSize() const {
+  size_t _size = 1;
+  if (x() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varUintSize(_data_x.size());
+    for (const int32_t &_it : _data_x) _size += kiwi::ByteBuffer::varIntSize(_it);
+  }
+  return _size;
+}
+
+bool IntArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   uint32_t _count;
   while (true) {
     uint32_t _type;
@@ -2290,7 +2941,9 @@ bool IntArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, con
         return true;
       case 1: {
         if (!_bb.readVarUint(_count)) return false;
-        for (int32_t &_it : set_x(_pool, _count)) if (!_bb.readVarInt(_it)) return false;
+        kiwi::Array<int32_t> _x_array = _pool.arrayUninitialized<int32_t>(_count);
+        if (!_bb.readVarIntArray(_x_array.data(), _count)) return false;
+        _flags[0] |= 1; _data_x = _x_array;
         break;
       }
       default: {
@@ -2314,16 +2967,32 @@ kiwi::Array<uint32_t> &UintArrayMessage::set_x(kiwi::MemoryPool &pool, uint32_t
 }
 
 bool UintArrayMessage::encode(kiwi::ByteBuffer &_bb) {
+  uint8_t *_out;
   if (x() != nullptr) {
     _bb.writeVarUint(1);
     _bb.writeVarUint(_data_x.size());
-    for (uint32_t &_it : _data_x) _bb.writeVarUint(_it);
+    for (const uint32_t *_p = _data_x.begin(), *_end = _data_x.end(); _p != _end;) {
+      size_t _count = _bb.writeBatchSize(_end - _p, 5);
+      if (_count == 0) { const uint32_t &_it = *_p++; _bb.writeVarUint(_it); continue; }
+      _out = _bb.beginWrite(5 * _count);
+      for (const uint32_t *_batch = _p + _count; _p != _batch; _p++) { const uint32_t &_it = *_p; kiwi::ByteBuffer::putVarUint(_out, _it); }
+      _bb.endWrite(_out);
+    }
   }
   _bb.writeVarUint(0);
   return true;
 }
 
-bool UintArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t UintArrayMessage::encodedSize() const {
+  size_t _size = 1;
+  if (x() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varUintSize(_data_x.size());
+    for (const uint32_t &_it : _data_x) _size += kiwi::ByteBuffer::varUintSize(_it);
+  }
+  return _size;
+}
+
+bool UintArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   uint32_t _count;
   while (true) {
     uint32_t _type;
@@ -2333,7 +3002,9 @@ bool UintArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, co
         return true;
       case 1: {
         if (!_bb.readVarUint(_count)) return false;
-        for (uint32_t &_it : set_x(_pool, _count)) if (!_bb.readVarUint(_it)) return false;
+        kiwi::Array<uint32_t> _x_array = _pool.arrayUninitialized<uint32_t>(_count);
+        if (!_bb.readVarUintArray(_x_array.data(), _count)) return false;
+        _flags[0] |= 1; _data_x = _x_array;
         break;
       }
       default: {
@@ -2357,16 +3028,32 @@ kiwi::Array<int64_t> &Int64ArrayMessage::set_x(kiwi::MemoryPool &pool, uint32_t
 }
 
 bool Int64ArrayMessage::encode(kiwi::ByteBuffer &_bb) {
+  uint8_t *_out;
   if (x() != nullptr) {
     _bb.writeVarUint(1);
     _bb.writeVarUint(_data_x.size());
-    for (int64_t &_it : _data_x) _bb.writeVarInt64(_it);
+    for (const int64_t *_p = _data_x.begin(), *_end = _data_x.end(); _p != _end;) {
+      size_t _count = _bb.writeBatchSize(_end - _p, 9);
+      if (_count == 0) { const int64_t &_it = *_p++; _bb.writeVarInt64(_it); continue; }
+      _out = _bb.beginWrite(9 * _count);
+      for (const int64_t *_batch = _p + _count; _p != _batch; _p++) { const int64_t &_it = *_p; kiwi::ByteBuffer::putVarInt64(_out, _it); }
+      _bb.endWrite(_out);
+    }
   }
   _bb.writeVarUint(0);
   return true;
 }
 
-bool Int64ArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t Int64ArrayMessage::encodedSize() const {
+  size_t _size = 1;
+  if (x() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varUintSize(_data_x.size());
+    for (const int64_t &_it : _data_x) _size += kiwi::ByteBuffer::varInt64Size(_it);
+  }
+  return _size;
+}
+
+bool Int64ArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   uint32_t _count;
   while (true) {
     uint32_t _type;
@@ -2376,7 +3063,9 @@ bool Int64ArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, c
         return true;
       case 1: {
         if (!_bb.readVarUint(_count)) return false;
-        for (int64_t &_it : set_x(_pool, _count)) if (!_bb.readVarInt64(_it)) return false;
+        kiwi::Array<int64_t> _x_array = _pool.arrayUninitialized<int64_t>(_count);
+        for (int64_t &_it : _x_array) if (!_bb.readVarInt64(_it)) return false;
+        _flags[0] |= 1; _data_x = _x_array;
         break;
       }
       default: {
@@ -2400,16 +3089,32 @@ kiwi::Array<uint64_t> &Uint64ArrayMessage::set_x(kiwi::MemoryPool &pool, uint32_
 }
 
 bool Uint64ArrayMessage::encode(kiwi::ByteBuffer &_bb) {
+  uint8_t *_out;
   if (x() != nullptr) {
     _bb.writeVarUint(1);
     _bb.writeVarUint(_data_x.size());
-    for (uint64_t &_it : _data_x) _bb.writeVarUint64(_it);
+    for (const uint64_t *_p = _data_x.begin(), *_end = _data_x.end(); _p != _end;) {
+      size_t _count = _bb.writeBatchSize(_end - _p, 9);
+      if (_count == 0) { const uint64_t &_it = *_p++; _bb.writeVarUint64(_it); continue; }
+      _out = _bb.beginWrite(9 * _count);
+      for (const uint64_t *_batch = _p + _count; _p != _batch; _p++) { const uint64_t &_it = *_p; kiwi::ByteBuffer::putVarUint64(_out, _it); }
+      _bb.endWrite(_out);
+    }
   }
   _bb.writeVarUint(0);
   return true;
 }
 
-bool Uint64ArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t Uint64ArrayMessage::encodedSize() const {
+  size_t _size = 1;
+  if (x() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varUintSize(_data_x.size());
+    for (const uint64_t &_it : _data_x) _size += kiwi::ByteBuffer::varUint64Size(_it);
+  }
+  return _size;
+}
+
+bool Uint64ArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   uint32_t _count;
   while (true) {
     uint32_t _type;
@@ -2419,7 +3124,9 @@ bool Uint64ArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool,
         return true;
       case 1: {
         if (!_bb.readVarUint(_count)) return false;
-        for (uint64_t &_it : set_x(_pool, _count)) if (!_bb.readVarUint64(_it)) return false;
+        kiwi::Array<uint64_t> _x_array = _pool.arrayUninitialized<uint64_t>(_count);
+        for (uint64_t &_it : _x_array) if (!_bb.readVarUint64(_it)) return false;
+        _flags[0] |= 1; _data_x = _x_array;
         break;
       }
       default: {
@@ -2443,16 +3150,32 @@ kiwi::Array<float> &FloatArrayMessage::set_x(kiwi::MemoryPool &pool, uint32_t co
 }
 
 bool FloatArrayMessage::encode(kiwi::ByteBuffer &_bb) {
+  uint8_t *_out;
   if (x() != nullptr) {
     _bb.writeVarUint(1);
     _bb.writeVarUint(_data_x.size());
-    for (float &_it : _data_x) _bb.writeVarFloat(_it);
+    for (const float *_p = _data_x.begin(), *_end = _data_x.end(); _p != _end;) {
+      size_t _count = _bb.writeBatchSize(_end - _p, 4);
+      if (_count == 0) { const float &_it = *_p++; _bb.writeVarFloat(_it); continue; }
+      _out = _bb.beginWrite(4 * _count);
+      for (const float *_batch = _p + _count; _p != _batch; _p++) { const float &_it = *_p; kiwi::ByteBuffer::putVarFloat(_out, _it); }
+      _bb.endWrite(_out);
+    }
   }
   _bb.writeVarUint(0);
   return true;
 }
 
-bool FloatArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t FloatArrayMessage::encodedSize() const {
+  size_t _size = 1;
+  if (x() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varUintSize(_data_x.size());
+    for (const float &_it : _data_x) _size += kiwi::ByteBuffer::varFloatSize(_it);
+  }
+  return _size;
+}
+
+bool FloatArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   uint32_t _count;
   while (true) {
     uint32_t _type;
@@ -2462,7 +3185,9 @@ bool FloatArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, c
         return true;
       case 1: {
         if (!_bb.readVarUint(_count)) return false;
-        for (float &_it : set_x(_pool, _count)) if (!_bb.readVarFloat(_it)) return false;
+        kiwi::Array<float> _x_array = _pool.arrayUninitialized<float>(_count);
+        for (float &_it : _x_array) if (!_bb.readVarFloat(_it)) return false;
+        _flags[0] |= 1; _data_x = _x_array;
         break;
       }
       default: {
@@ -2489,13 +3214,22 @@ bool StringArrayMessage::encode(kiwi::ByteBuffer &_bb) {
   if (x() != nullptr) {
     _bb.writeVarUint(1);
     _bb.writeVarUint(_data_x.size());
-    for (kiwi::String &_it : _data_x) _bb.writeString(_it.c_str());
+    for (kiwi::String &_it : _data_x) _bb.writeString(_it);
   }
   _bb.writeVarUint(0);
   return true;
 }
 
-bool StringArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t StringArrayMessage::encodedSize() const {
+  size_t _size = 1;
+  if (x() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varUintSize(_data_x.size());
+    for (const kiwi::String &_it : _data_x) _size += (_it.size() + 1);
+  }
+  return _size;
+}
+
+bool StringArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   uint32_t _count;
   while (true) {
     uint32_t _type;
@@ -2505,7 +3239,9 @@ bool StringArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool,
         return true;
       case 1: {
         if (!_bb.readVarUint(_count)) return false;
-        for (kiwi::String &_it : set_x(_pool, _count)) if (!_bb.readString(_it, _pool)) return false;
+        kiwi::Array<kiwi::String> _x_array = _pool.array<kiwi::String>(_count);
+        for (kiwi::String &_it : _x_array) if (!(_borrow ? _bb.readBorrowedString(_it) : _bb.readString(_it, _pool))) return false;
+        _flags[0] |= 1; _data_x = _x_array;
         break;
       }
       default: {
@@ -2541,21 +3277,47 @@ kiwi::Array<uint32_t> &CompoundArrayMessage::set_y(kiwi::MemoryPool &pool, uint3
 }
 
 bool CompoundArrayMessage::encode(kiwi::ByteBuffer &_bb) {
+  uint8_t *_out;
   if (x() != nullptr) {
     _bb.writeVarUint(1);
     _bb.writeVarUint(_data_x.size());
-    for (uint32_t &_it : _data_x) _bb.writeVarUint(_it);
+    for (const uint32_t *_p = _data_x.begin(), *_end = _data_x.end(); _p != _end;) {
+      size_t _count = _bb.writeBatchSize(_end - _p, 5);
+      if (_count == 0) { const uint32_t &_it = *_p++; _bb.writeVarUint(_it); continue; }
+      _out = _bb.beginWrite(5 * _count);
+      for (const uint32_t *_batch = _p + _count; _p != _batch; _p++) { const uint32_t &_it = *_p; kiwi::ByteBuffer::putVarUint(_out, _it); }
+      _bb.endWrite(_out);
+    }
   }
   if (y() != nullptr) {
     _bb.writeVarUint(2);
     _bb.writeVarUint(_data_y.size());
-    for (uint32_t &_it : _data_y) _bb.writeVarUint(_it);
+    for (const uint32_t *_p = _data_y.begin(), *_end = _data_y.end(); _p != _end;) {
+      size_t _count = _bb.writeBatchSize(_end - _p, 5);
+      if (_count == 0) { const uint32_t &_it = *_p++; _bb.writeVarUint(_it); continue; }
+      _out = _bb.beginWrite(5 * _count);
+      for (const uint32_t *_batch = _p + _count; _p != _batch; _p++) { const uint32_t &_it = *_p; kiwi::ByteBuffer::putVarUint(_out, _it); }
+      _bb.endWrite(_out);
+    }
   }
   _bb.writeVarUint(0);
   return true;
 }
 
-bool CompoundArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t CompoundArrayMessage::encodedSize() const {
+  size_t _size = 1;
+  if (x() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varUintSize(_data_x.size());
+    for (const uint32_t &_it : _data_x) _size += kiwi::ByteBuffer::varUintSize(_it);
+  }
+  if (y() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varUintSize(_data_y.size());
+    for (const uint32_t &_it : _data_y) _size += kiwi::ByteBuffer::varUintSize(_it);
+  }
+  return _size;
+}
+
+bool CompoundArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   uint32_t _count;
   while (true) {
     uint32_t _type;
@@ -2565,12 +3327,16 @@ bool CompoundArrayMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool
         return true;
       case 1: {
         if (!_bb.readVarUint(_count)) return false;
-        for (uint32_t &_it : set_x(_pool, _count)) if (!_bb.readVarUint(_it)) return false;
+        kiwi::Array<uint32_t> _x_array = _pool.arrayUninitialized<uint32_t>(_count);
+        if (!_bb.readVarUintArray(_x_array.data(), _count)) return false;
+        _flags[0] |= 1; _data_x = _x_array;
         break;
       }
       case 2: {
         if (!_bb.readVarUint(_count)) return false;
-        for (uint32_t &_it : set_y(_pool, _count)) if (!_bb.readVarUint(_it)) return false;
+        kiwi::Array<uint32_t> _y_array = _pool.arrayUninitialized<uint32_t>(_count);
+        if (!_bb.readVarUintArray(_y_array.data(), _count)) return false;
+        _flags[0] |= 2; _data_y = _y_array;
         break;
       }
       default: {
@@ -2602,7 +3368,15 @@ bool RecursiveMessage::encode(kiwi::ByteBuffer &_bb) {
   return true;
 }
 
-bool RecursiveMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t RecursiveMessage::encodedSize() const {
+  size_t _size = 1;
+  if (x() != nullptr) {
+    _size += 1 + _data_x->encodedSize();
+  }
+  return _size;
+}
+
+bool RecursiveMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   while (true) {
     uint32_t _type;
     if (!_bb.readVarUint(_type)) return false;
@@ -2611,7 +3385,7 @@ bool RecursiveMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, co
         return true;
       case 1: {
         _data_x = _pool.allocate<RecursiveMessage>();
-        if (!_data_x->decode(_bb, _pool, _schema)) return false;
+        if (!_data_x->decode(_bb, _pool, _schema, _borrow)) return false;
         break;
       }
       default: {
@@ -2707,6 +3481,7 @@ void NonDeprecatedMessage::set_g(const uint32_t &value) {
 }
 
 bool NonDeprecatedMessage::encode(kiwi::ByteBuffer &_bb) {
+  uint8_t *_out;
   if (a() != nullptr) {
     _bb.writeVarUint(1);
     _bb.writeVarUint(_data_a);
@@ -2718,12 +3493,24 @@ bool NonDeprecatedMessage::encode(kiwi::ByteBuffer &_bb) {
   if (c() != nullptr) {
     _bb.writeVarUint(3);
     _bb.writeVarUint(_data_c.size());
-    for (uint32_t &_it : _data_c) _bb.writeVarUint(_it);
+    for (const uint32_t *_p = _data_c.begin(), *_end = _data_c.end(); _p != _end;) {
+      size_t _count = _bb.writeBatchSize(_end - _p, 5);
+      if (_count == 0) { const uint32_t &_it = *_p++; _bb.writeVarUint(_it); continue; }
+      _out = _bb.beginWrite(5 * _count);
+      for (const uint32_t *_batch = _p + _count; _p != _batch; _p++) { const uint32_t &_it = *_p; kiwi::ByteBuffer::putVarUint(_out, _it); }
+      _bb.endWrite(_out);
+    }
   }
   if (d() != nullptr) {
     _bb.writeVarUint(4);
     _bb.writeVarUint(_data_d.size());
-    for (uint32_t &_it : _data_d) _bb.writeVarUint(_it);
+    for (const uint32_t *_p = _data_d.begin(), *_end = _data_d.end(); _p != _end;) {
+      size_t _count = _bb.writeBatchSize(_end - _p, 5);
+      if (_count == 0) { const uint32_t &_it = *_p++; _bb.writeVarUint(_it); continue; }
+      _out = _bb.beginWrite(5 * _count);
+      for (const uint32_t *_batch = _p + _count; _p != _batch; _p++) { const uint32_t &_it = *_p; kiwi::ByteBuffer::putVarUint(_out, _it); }
+      _bb.endWrite(_out);
+    }
   }
   if (e() != nullptr) {
     _bb.writeVarUint(5);
@@ -2741,7 +3528,35 @@ bool NonDeprecatedMessage::encode(kiwi::ByteBuffer &_bb) {
   return true;
 }
 
-bool NonDeprecatedMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t NonDeprecatedMessage::encodedSize() const {
+  size_t _size = 1;
+  if (a() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varUintSize(_data_a);
+  }
+  if (b() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varUintSize(_data_b);
+  }
+  if (c() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varUintSize(_data_c.size());
+    for (const uint32_t &_it : _data_c) _size += kiwi::ByteBuffer::varUintSize(_it);
+  }
+  if (d() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varUintSize(_data_d.size());
+    for (const uint32_t &_it : _data_d) _size += kiwi::ByteBuffer::varUintSize(_it);
+  }
+  if (e() != nullptr) {
+    _size += 1 + _data_e->encodedSize();
+  }
+  if (f() != nullptr) {
+    _size += 1 + _data_f->encodedSize();
+  }
+  if (g() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varUintSize(_data_g);
+  }
+  return _size;
+}
+
+bool NonDeprecatedMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   uint32_t _count;
   while (true) {
     uint32_t _type;
@@ -2761,22 +3576,26 @@ bool NonDeprecatedMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool
       }
       case 3: {
         if (!_bb.readVarUint(_count)) return false;
-        for (uint32_t &_it : set_c(_pool, _count)) if (!_bb.readVarUint(_it)) return false;
+        kiwi::Array<uint32_t> _c_array = _pool.arrayUninitialized<uint32_t>(_count);
+        if (!_bb.readVarUintArray(_c_array.data(), _count)) return false;
+        _flags[0] |= 4; _data_c = _c_array;
         break;
       }
       case 4: {
         if (!_bb.readVarUint(_count)) return false;
-        for (uint32_t &_it : set_d(_pool, _count)) if (!_bb.readVarUint(_it)) return false;
+        kiwi::Array<uint32_t> _d_array = _pool.arrayUninitialized<uint32_t>(_count);
+        if (!_bb.readVarUintArray(_d_array.data(), _count)) return false;
+        _flags[0] |= 8; _data_d = _d_array;
         break;
       }
       case 5: {
         _data_e = _pool.allocate<ByteStruct>();
-        if (!_data_e->decode(_bb, _pool, _schema)) return false;
+        if (!_data_e->decode(_bb, _pool, _schema, _borrow)) return false;
         break;
       }
       case 6: {
         _data_f = _pool.allocate<ByteStruct>();
-        if (!_data_f->decode(_bb, _pool, _schema)) return false;
+        if (!_data_f->decode(_bb, _pool, _schema, _borrow)) return false;
         break;
       }
       case 7: {
@@ -2841,6 +3660,7 @@ void DeprecatedMessage::set_g(const uint32_t &value) {
 }
 
 bool DeprecatedMessage::encode(kiwi::ByteBuffer &_bb) {
+  uint8_t *_out;
   if (a() != nullptr) {
     _bb.writeVarUint(1);
     _bb.writeVarUint(_data_a);
@@ -2848,7 +3668,13 @@ bool DeprecatedMessage::encode(kiwi::ByteBuffer &_bb) {
   if (c() != nullptr) {
     _bb.writeVarUint(3);
     _bb.writeVarUint(_data_c.size());
-    for (uint32_t &_it : _data_c) _bb.writeVarUint(_it);
+    for (const uint32_t *_p = _data_c.begin(), *_end = _data_c.end(); _p != _end;) {
+      size_t _count = _bb.writeBatchSize(_end - _p, 5);
+      if (_count == 0) { const uint32_t &_it = *_p++; _bb.writeVarUint(_it); continue; }
+      _out = _bb.beginWrite(5 * _count);
+      for (const uint32_t *_batch = _p + _count; _p != _batch; _p++) { const uint32_t &_it = *_p; kiwi::ByteBuffer::putVarUint(_out, _it); }
+      _bb.endWrite(_out);
+    }
   }
   if (e() != nullptr) {
     _bb.writeVarUint(5);
@@ -2862,7 +3688,25 @@ bool DeprecatedMessage::encode(kiwi::ByteBuffer &_bb) {
   return true;
 }
 
-bool DeprecatedMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t DeprecatedMessage::encodedSize() const {
+  size_t _size = 1;
+  if (a() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varUintSize(_data_a);
+  }
+  if (c() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varUintSize(_data_c.size());
+    for (const uint32_t &_it : _data_c) _size += kiwi::ByteBuffer::varUintSize(_it);
+  }
+  if (e() != nullptr) {
+    _size += 1 + _data_e->encodedSize();
+  }
+  if (g() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varUintSize(_data_g);
+  }
+  return _size;
+}
+
+bool DeprecatedMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   uint32_t _count;
   while (true) {
     uint32_t _type;
@@ -2882,22 +3726,25 @@ bool DeprecatedMessage::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, c
       }
       case 3: {
         if (!_bb.readVarUint(_count)) return false;
-        for (uint32_t &_it : set_c(_pool, _count)) if (!_bb.readVarUint(_it)) return false;
+        kiwi::Array<uint32_t> _c_array = _pool.arrayUninitialized<uint32_t>(_count);
+        if (!_bb.readVarUintArray(_c_array.data(), _count)) return false;
+        _flags[0] |= 4; _data_c = _c_array;
         break;
       }
       case 4: {
         if (!_bb.readVarUint(_count)) return false;
-        for (uint32_t &_it : _pool.array<uint32_t>(_count)) if (!_bb.readVarUint(_it)) return false;
+        kiwi::Array<uint32_t> _d_array = _pool.arrayUninitialized<uint32_t>(_count);
+        if (!_bb.readVarUintArray(_d_array.data(), _count)) return false;
         break;
       }
       case 5: {
         _data_e = _pool.allocate<ByteStruct>();
-        if (!_data_e->decode(_bb, _pool, _schema)) return false;
+        if (!_data_e->decode(_bb, _pool, _schema, _borrow)) return false;
         break;
       }
       case 6: {
         ByteStruct *_data_f = _pool.allocate<ByteStruct>();
-        if (!_data_f->decode(_bb, _pool, _schema)) return false;
+        if (!_data_f->decode(_bb, _pool, _schema, _borrow)) return false;
         break;
       }
       case 7: {
@@ -3202,6 +4049,7 @@ kiwi::Array<uint64_t> &SortedStruct::set_h3(kiwi::MemoryPool &pool, uint32_t cou
 }
 
 bool SortedStruct::encode(kiwi::ByteBuffer &_bb) {
+  uint8_t *_out;
   if (a1() == nullptr) return false;
   _bb.writeByte(_data_a1);
   if (b1() == nullptr) return false;
@@ -3213,7 +4061,7 @@ bool SortedStruct::encode(kiwi::ByteBuffer &_bb) {
   if (e1() == nullptr) return false;
   _bb.writeVarFloat(_data_e1);
   if (f1() == nullptr) return false;
-  _bb.writeString(_data_f1.c_str());
+  _bb.writeString(_data_f1);
   if (g1() == nullptr) return false;
   _bb.writeVarInt64(_data_g1);
   if (h1() == nullptr) return false;
@@ -3229,40 +4077,160 @@ bool SortedStruct::encode(kiwi::ByteBuffer &_bb) {
   if (e2() == nullptr) return false;
   _bb.writeVarFloat(_data_e2);
   if (f2() == nullptr) return false;
-  _bb.writeString(_data_f2.c_str());
+  _bb.writeString(_data_f2);
   if (g2() == nullptr) return false;
   _bb.writeVarInt64(_data_g2);
   if (h2() == nullptr) return false;
   _bb.writeVarUint64(_data_h2);
   if (a3() == nullptr) return false;
   _bb.writeVarUint(_data_a3.size());
-  for (bool &_it : _data_a3) _bb.writeByte(_it);
+  for (const bool *_p = _data_a3.begin(), *_end = _data_a3.end(); _p != _end;) {
+    size_t _count = _bb.writeBatchSize(_end - _p, 1);
+    if (_count == 0) { const bool &_it = *_p++; _bb.writeByte(_it); continue; }
+    _out = _bb.beginWrite(1 * _count);
+    for (const bool *_batch = _p + _count; _p != _batch; _p++) { const bool &_it = *_p; kiwi::ByteBuffer::putByte(_out, _it); }
+    _bb.endWrite(_out);
+  }
   if (b3() == nullptr) return false;
   _bb.writeVarUint(_data_b3.size());
-  for (uint8_t &_it : _data_b3) _bb.writeByte(_it);
+  _bb.writeBytes(_data_b3.data(), _data_b3.size());
   if (c3() == nullptr) return false;
   _bb.writeVarUint(_data_c3.size());
-  for (int32_t &_it : _data_c3) _bb.writeVarInt(_it);
+  for (const int32_t *_p = _data_c3.begin(), *_end = _data_c3.end(); _p != _end;) {
+    size_t _count = _bb.writeBatchSize(_end - _p, 5);
+    if (_count == 0) { const int32_t &_it = *_p++; _bb.writeVarInt(_it); continue; }
+    _out = _bb.beginWrite(5 * _count);
+    for (const int32_t *_batch = _p + _count; _p != _batch; _p++) { const int32_t &_it = *_p; kiwi::ByteBuffer::putVarInt(_out, _it); }
+    _bb.endWrite(_out);
+  }
   if (d3() == nullptr) return false;
   _bb.writeVarUint(_data_d3.size());
-  for (uint32_t &_it : _data_d3) _bb.writeVarUint(_it);
+  for (const uint32_t *_p = _data_d3.begin(), *_end = _data_d3.end(); _p != _end;) {
+    size_t _count = _bb.writeBatchSize(_end - _p, 5);
+    if (_count == 0) { const uint32_t &_it = *_p++; _bb.writeVarUint(_it); continue; }
+    _out = _bb.beginWrite(5 * _count);
+    for (const uint32_t *_batch = _p + _count; _p != _batch; _p++) { const uint32_t &_it = *_p; kiwi::ByteBuffer::putVarUint(_out, _it); }
+    _bb.endWrite(_out);
+  }
   if (e3() == nullptr) return false;
   _bb.writeVarUint(_data_e3.size());
-  for (float &_it : _data_e3) _bb.writeVarFloat(_it);
+  for (const float *_p = _data_e3.begin(), *_end = _data_e3.end(); _p != _end;) {
+    size_t _count = _bb.writeBatchSize(_end - _p, 4);
+    if (_count == 0) { const float &_it = *_p++; _bb.writeVarFloat(_it); continue; }
+    _out = _bb.beginWrite(4 * _count);
+    for (const float *_batch = _p + _count; _p != _batch; _p++) { const float &_it = *_p; kiwi::ByteBuffer::putVarFloat(_out, _it); }
+    _bb.endWrite(_out);
+  }
   if (f3() == nullptr) return false;
   _bb.writeVarUint(_data_f3.size());
-  for (kiwi::String &_it : _data_f3) _bb.writeString(_it.c_str());
+  for (kiwi::String &_it : _data_f3) _bb.writeString(_it);
   if (g3() == nullptr) return false;
   _bb.writeVarUint(_data_g3.size());
-  for (int64_t &_it : _data_g3) _bb.writeVarInt64(_it);
+  for (const int64_t *_p = _data_g3.begin(), *_end = _data_g3.end(); _p != _end;) {
+    size_t _count = _bb.writeBatchSize(_end - _p, 9);
+    if (_count == 0) { const int64_t &_it = *_p++; _bb.writeVarInt64(_it); continue; }
+    _out = _bb.beginWrite(9 * _count);
+    for (const int64_t *_batch = _p + _count; _p != _batch; _p++) { const int64_t &_it = *_p; kiwi::ByteBuffer::putVarInt64(_out, _it); }
+    _bb.endWrite(_out);
+  }
   if (h3() == nullptr) return false;
   _bb.writeVarUint(_data_h3.size());
-  for (uint64_t &_it : _data_h3) _bb.writeVarUint64(_it);
+  for (const uint64_t *_p = _data_h3.begin(), *_end = _data_h3.end(); _p != _end;) {
+    size_t _count = _bb.writeBatchSize(_end - _p, 9);
+    if (_count == 0) { const uint64_t &_it = *_p++; _bb.writeVarUint64(_it); continue; }
+    _out = _bb.beginWrite(9 * _count);
+    for (const uint64_t *_batch = _p + _count; _p != _batch; _p++) { const uint64_t &_it = *_p; kiwi::ByteBuffer::putVarUint64(_out, _it); }
+    _bb.endWrite(_out);
+  }
   return true;
 }
 
-bool SortedStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t SortedStruct::encodedSize() const {
+  size_t _size = 0;
+  if (a1() != nullptr) {
+    _size += 1;
+  }
+  if (b1() != nullptr) {
+    _size += 1;
+  }
+  if (c1() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_c1);
+  }
+  if (d1() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_d1);
+  }
+  if (e1() != nullptr) {
+    _size += kiwi::ByteBuffer::varFloatSize(_data_e1);
+  }
+  if (f1() != nullptr) {
+    _size += (_data_f1.size() + 1);
+  }
+  if (g1() != nullptr) {
+    _size += kiwi::ByteBuffer::varInt64Size(_data_g1);
+  }
+  if (h1() != nullptr) {
+    _size += kiwi::ByteBuffer::varUint64Size(_data_h1);
+  }
+  if (a2() != nullptr) {
+    _size += 1;
+  }
+  if (b2() != nullptr) {
+    _size += 1;
+  }
+  if (c2() != nullptr) {
+    _size += kiwi::ByteBuffer::varIntSize(_data_c2);
+  }
+  if (d2() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_d2);
+  }
+  if (e2() != nullptr) {
+    _size += kiwi::ByteBuffer::varFloatSize(_data_e2);
+  }
+  if (f2() != nullptr) {
+    _size += (_data_f2.size() + 1);
+  }
+  if (g2() != nullptr) {
+    _size += kiwi::ByteBuffer::varInt64Size(_data_g2);
+  }
+  if (h2() != nullptr) {
+    _size += kiwi::ByteBuffer::varUint64Size(_data_h2);
+  }
+  if (a3() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_a3.size()) + _data_a3.size();
+  }
+  if (b3() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_b3.size()) + _data_b3.size();
+  }
+  if (c3() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_c3.size());
+    for (const int32_t &_it : _data_c3) _size += kiwi::ByteBuffer::varIntSize(_it);
+  }
+  if (d3() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_d3.size());
+    for (const uint32_t &_it : _data_d3) _size += kiwi::ByteBuffer::varUintSize(_it);
+  }
+  if (e3() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_e3.size());
+    for (const float &_it : _data_e3) _size += kiwi::ByteBuffer::varFloatSize(_it);
+  }
+  if (f3() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_f3.size());
+    for (const kiwi::String &_it : _data_f3) _size += (_it.size() + 1);
+  }
+  if (g3() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_g3.size());
+    for (const int64_t &_it : _data_g3) _size += kiwi::ByteBuffer::varInt64Size(_it);
+  }
+  if (h3() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_h3.size());
+    for (const uint64_t &_it : _data_h3) _size += kiwi::ByteBuffer::varUint64Size(_it);
+  }
+  return _size;
+}
+
+bool SortedStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   uint32_t _count;
+  const uint8_t *_bytes;
   if (!_bb.readByte(_data_a1)) return false;
   set_a1(_data_a1);
   if (!_bb.readByte(_data_b1)) return false;
@@ -3273,7 +4241,7 @@ bool SortedStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const
   set_d1(_data_d1);
   if (!_bb.readVarFloat(_data_e1)) return false;
   set_e1(_data_e1);
-  if (!_bb.readString(_data_f1, _pool)) return false;
+  if (!(_borrow ? _bb.readBorrowedString(_data_f1) : _bb.readString(_data_f1, _pool))) return false;
   set_f1(_data_f1);
   if (!_bb.readVarInt64(_data_g1)) return false;
   set_g1(_data_g1);
@@ -3289,28 +4257,149 @@ bool SortedStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const
   set_d2(_data_d2);
   if (!_bb.readVarFloat(_data_e2)) return false;
   set_e2(_data_e2);
-  if (!_bb.readString(_data_f2, _pool)) return false;
+  if (!(_borrow ? _bb.readBorrowedString(_data_f2) : _bb.readString(_data_f2, _pool))) return false;
   set_f2(_data_f2);
   if (!_bb.readVarInt64(_data_g2)) return false;
   set_g2(_data_g2);
   if (!_bb.readVarUint64(_data_h2)) return false;
   set_h2(_data_h2);
   if (!_bb.readVarUint(_count)) return false;
-  for (bool &_it : set_a3(_pool, _count)) if (!_bb.readByte(_it)) return false;
+  kiwi::Array<bool> _a3_array = _pool.arrayUninitialized<bool>(_count);
+  for (bool &_it : _a3_array) if (!_bb.readByte(_it)) return false;
+  _flags[0] |= 65536; _data_a3 = _a3_array;
+  if (!_bb.readVarUint(_count) || !(_borrow ? _bb.readBorrowedBytes(_bytes, _count) : _bb.readBytes(_bytes, _count))) return false;
+  _flags[0] |= 131072; _data_b3 = _borrow ? kiwi::Array<uint8_t>(const_cast<uint8_t *>(_bytes), _count) : _pool.array(_bytes, _count);
   if (!_bb.readVarUint(_count)) return false;
-  for (uint8_t &_it : set_b3(_pool, _count)) if (!_bb.readByte(_it)) return false;
+  kiwi::Array<int32_t> _c3_array = _pool.arrayUninitialized<int32_t>(_count);
+  if (!_bb.readVarIntArray(_c3_array.data(), _count)) return false;
+  _flags[0] |= 262144; _data_c3 = _c3_array;
   if (!_bb.readVarUint(_count)) return false;
-  for (int32_t &_it : set_c3(_pool, _count)) if (!_bb.readVarInt(_it)) return false;
+  kiwi::Array<uint32_t> _d3_array = _pool.arrayUninitialized<uint32_t>(_count);
+  if (!_bb.readVarUintArray(_d3_array.data(), _count)) return false;
+  _flags[0] |= 524288; _data_d3 = _d3_array;
   if (!_bb.readVarUint(_count)) return false;
-  for (uint32_t &_it : set_d3(_pool, _count)) if (!_bb.readVarUint(_it)) return false;
+  kiwi::Array<float> _e3_array = _pool.arrayUninitialized<float>(_count);
+  for (float &_it : _e3_array) if (!_bb.readVarFloat(_it)) return false;
+  _flags[0] |= 1048576; _data_e3 = _e3_array;
   if (!_bb.readVarUint(_count)) return false;
-  for (float &_it : set_e3(_pool, _count)) if (!_bb.readVarFloat(_it)) return false;
+  kiwi::Array<kiwi::String> _f3_array = _pool.array<kiwi::String>(_count);
+  for (kiwi::String &_it : _f3_array) if (!(_borrow ? _bb.readBorrowedString(_it) : _bb.readString(_it, _pool))) return false;
+  _flags[0] |= 2097152; _data_f3 = _f3_array;
   if (!_bb.readVarUint(_count)) return false;
-  for (kiwi::String &_it : set_f3(_pool, _count)) if (!_bb.readString(_it, _pool)) return false;
+  kiwi::Array<int64_t> _g3_array = _pool.arrayUninitialized<int64_t>(_count);
+  for (int64_t &_it : _g3_array) if (!_bb.readVarInt64(_it)) return false;
+  _flags[0] |= 4194304; _data_g3 = _g3_array;
   if (!_bb.readVarUint(_count)) return false;
-  for (int64_t &_it : set_g3(_pool, _count)) if (!_bb.readVarInt64(_it)) return false;
+  kiwi::Array<uint64_t> _h3_array = _pool.arrayUninitialized<uint64_t>(_count);
+  for (uint64_t &_it : _h3_array) if (!_bb.readVarUint64(_it)) return false;
+  _flags[0] |= 8388608; _data_h3 = _h3_array;
+  return true;
+}
+
+kiwi::String *StringPairStruct::a() {
+  return _flags[0] & 1 ? &_data_a : nullptr;
+}
+
+const kiwi::String *StringPairStruct::a() const {
+  return _flags[0] & 1 ? &_data_a : nullptr;
+}
+
+void StringPairStruct::set_a(const kiwi::String &value) {
+  _flags[0] |= 1; _data_a = value;
+}
+
+kiwi::String *StringPairStruct::b() {
+  return _flags[0] & 2 ? &_data_b : nullptr;
+}
+
+const kiwi::String *StringPairStruct::b() const {
+  return _flags[0] & 2 ? &_data_b : nullptr;
+}
+
+void StringPairStruct::set_b(const kiwi::String &value) {
+  _flags[0] |= 2; _data_b = value;
+}
+
+uint32_t *StringPairStruct::c() {
+  return _flags[0] & 4 ? &_data_c : nullptr;
+}
+
+const uint32_t *StringPairStruct::c() const {
+  return _flags[0] & 4 ? &_data_c : nullptr;
+}
+
+void StringPairStruct::set_c(const uint32_t &value) {
+  _flags[0] |= 4; _data_c = value;
+}
+
+bool StringPairStruct::encode(kiwi::ByteBuffer &_bb) {
+  if (a() == nullptr) return false;
+  _bb.writeString(_data_a);
+  if (b() == nullptr) return false;
+  _bb.writeString(_data_b);
+  if (c() == nullptr) return false;
+  _bb.writeVarUint(_data_c);
+  return true;
+}
+
+size_t StringPairStruct::encodedSize() const {
+  size_t _size = 0;
+  if (a() != nullptr) {
+    _size += (_data_a.size() + 1);
+  }
+  if (b() != nullptr) {
+    _size += (_data_b.size() + 1);
+  }
+  if (c() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_c);
+  }
+  return _size;
+}
+
+bool StringPairStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
+  if (!(_borrow ? _bb.readBorrowedString(_data_a) : _bb.readString(_data_a, _pool))) return false;
+  set_a(_data_a);
+  if (!(_borrow ? _bb.readBorrowedString(_data_b) : _bb.readString(_data_b, _pool))) return false;
+  set_b(_data_b);
+  if (!_bb.readVarUint(_data_c)) return false;
+  set_c(_data_c);
+  return true;
+}
+
+kiwi::Array<StringPairStruct> *StringPairArrayStruct::x() {
+  return _flags[0] & 1 ? &_data_x : nullptr;
+}
+
+const kiwi::Array<StringPairStruct> *StringPairArrayStruct::x() const {
+  return _flags[0] & 1 ? &_data_x : nullptr;
+}
+
+kiwi::Array<StringPairStruct> &StringPairArrayStruct::set_x(kiwi::MemoryPool &pool, uint32_t count) {
+  _flags[0] |= 1; return _data_x = pool.array<StringPairStruct>(count);
+}
+
+bool StringPairArrayStruct::encode(kiwi::ByteBuffer &_bb) {
+  if (x() == nullptr) return false;
+  _bb.writeVarUint(_data_x.size());
+  for (StringPairStruct &_it : _data_x) if (!_it.encode(_bb)) return false;
+  return true;
+}
+
+size_t StringPairArrayStruct::encodedSize() const {
+  size_t _size = 0;
+  if (x() != nullptr) {
+    _size += kiwi::ByteBuffer::varUintSize(_data_x.size());
+    for (const StringPairStruct &_it : _data_x) _size += _it.encodedSize();
+  }
+  return _size;
+}
+
+bool StringPairArrayStruct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
+  uint32_t _count;
   if (!_bb.readVarUint(_count)) return false;
-  for (uint64_t &_it : set_h3(_pool, _count)) if (!_bb.readVarUint64(_it)) return false;
+  kiwi::Array<StringPairStruct> _x_array = _pool.array<StringPairStruct>(_count);
+  for (StringPairStruct &_it : _x_array) if (!_it.decode(_bb, _pool, _schema, _borrow)) return false;
+  _flags[0] |= 1; _data_x = _x_array;
   return true;
 }
 
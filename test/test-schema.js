@@ -1850,3 +1850,74 @@ test["encodeSortedStruct"] = function (message, bb) {
 
   if (isTopLevel) return bb.toUint8Array();
 };
+
+test["decodeStringPairStruct"] = function (bb) {
+  var result = {};
+  if (!(bb instanceof this.ByteBuffer)) {
+    bb = new this.ByteBuffer(bb);
+  }
+
+  result["a"] = bb.readString();
+  result["b"] = bb.readString();
+  result["c"] = bb.readVarUint();
+  return result;
+};
+
+test["encodeStringPairStruct"] = function (message, bb) {
+  var isTopLevel = !bb;
+  if (isTopLevel) bb = new this.ByteBuffer();
+
+  var value = message["a"];
+  if (value != null) {
+    bb.writeString(value);
+  } else {
+    throw new Error("Missing required field \"a\"");
+  }
+
+  var value = message["b"];
+  if (value != null) {
+    bb.writeString(value);
+  } else {
+    throw new Error("Missing required field \"b\"");
+  }
+
+  var value = message["c"];
+  if (value != null) {
+    bb.writeVarUint(value);
+  } else {
+    throw new Error("Missing required field \"c\"");
+  }
+
+  if (isTopLevel) return bb.toUint8Array();
+};
+
+test["decodeStringPairArrayStruct"] = function (bb) {
+  var result = {};
+  if (!(bb instanceof this.ByteBuffer)) {
+    bb = new this.ByteBuffer(bb);
+  }
+
+  var length = bb.readVarUint();
+  var values = result["x"] = Array(length);
+  for (var i = 0; i < length; i++) values[i] = this["decodeStringPairStruct"](bb);
+  return result;
+};
+
+test["encodeStringPairArrayStruct"] = function (message, bb) {
+  var isTopLevel = !bb;
+  if (isTopLevel) bb = new this.ByteBuffer();
+
+  var value = message["x"];
+  if (value != null) {
+    var values = value, n = values.length;
+    bb.writeVarUint(n);
+    for (var i = 0; i < n; i++) {
+      value = values[i];
+      this["encodeStringPairStruct"](value, bb);
+    }
+  } else {
+    throw new Error("Missing required field \"x\"");
+  }
+
+  if (isTopLevel) return bb.toUint8Array();
+};
@@ -216,6 +216,16 @@ export namespace test {
     h3: bigint[];
   }
 
+  export interface StringPairStruct {
+    a: string;
+    b: string;
+    c: number;
+  }
+
+  export interface StringPairArrayStruct {
+    x: StringPairStruct[];
+  }
+
   export interface Schema {
     Enum: any;
     encodeEnumStruct(message: EnumStruct): Uint8Array;
@@ -304,5 +314,9 @@ export namespace test {
     decodeDeprecatedMessage(buffer: Uint8Array): DeprecatedMessage;
     encodeSortedStruct(message: SortedStruct): Uint8Array;
     decodeSortedStruct(buffer: Uint8Array): SortedStruct;
+    encodeStringPairStruct(message: StringPairStruct): Uint8Array;
+    decodeStringPairStruct(buffer: Uint8Array): StringPairStruct;
+    encodeStringPairArrayStruct(message: StringPairArrayStruct): Uint8Array;
+    decodeStringPairArrayStruct(buffer: Uint8Array): StringPairArrayStruct;
   }
 }
@@ -202,6 +202,12 @@ static void testStructString() {
     assert(s2.decode(bb2, pool));
     assert(s2.x());
     assert(*s2.x() == kiwi::String(i));
+    assert(s2.x()->size() == strlen(i));
+
+    // A string without a null terminator is invalid
+    kiwi::ByteBuffer bb3(o.data(), o.size() - 1);
+    test::StringStruct s3;
+    assert(!s3.decode(bb3, pool));
   };
 
   check("", {0});
@@ -665,11 +671,26 @@ static void testMessageByteArray() {
     test::ByteArrayMessage message2;
     assert(message2.decode(bb2, pool));
 
+    kiwi::ByteBuffer bb3(o.data(), o.size());
+    test::ByteArrayMessage message3;
+    assert(message3.decodeBorrowed(bb3, pool));
+
     if (present) {
       assert(message2.x());
       assert(std::vector<uint8_t>(message2.x()->begin(), message2.x()->end()) == i);
+      assert(message3.x());
+      assert(std::vector<uint8_t>(message3.x()->begin(), message3.x()->end()) == i);
+      assert(message3.x()->data() == o.data() + 2);
     } else {
       assert(!message2.x());
+      assert(!message3.x());
+    }
+
+    // Running out of data partway through the array must fail
+    if (present) {
+      kiwi::ByteBuffer bb4(o.data(), o.size() - 2);
+      test::ByteArrayMessage message4;
+      assert(!message4.decode(bb4, pool));
     }
   };
 
@@ -709,6 +730,54 @@ static void testBinarySchema() {
     kiwi::ByteBuffer file;
     assert(readFile("test-schema.bkiwi", file));
     assert(test_schema.parse(file));
+
+    // Definitions are found by name in the order they were declared
+    uint32_t index = 0;
+    assert(test_schema.findDefinition("Enum", index) && index == 0);
+    assert(test_schema.findDefinition("EnumStruct", index) && index == 1);
+    assert(test_schema.findDefinition(kiwi::String("BoolStruct"), index) && index == 2);
+    assert(!test_schema.findDefinition("Missing", index) && index == (uint32_t)-1);
+    assert(!test_schema.findDefinition("", index));
+    assert(!test_schema.findDefinition("enum", index));
+
+    // A failed parse can't find anything
+    uint8_t truncated[] = {1, 'E', 'n', 'u', 'm', 0};
+    kiwi::ByteBuffer bb(truncated, sizeof(truncated));
+    assert(!test_schema.parse(bb));
+    assert(!test_schema.findDefinition("Enum", index));
+  }
+
+  // Fields are found by id in both dense and sparse messages
+  for (uint32_t id : {2u, 1000u, 100000u}) {
+    kiwi::ByteBuffer schema;
+    schema.writeVarUint(1);
+    schema.writeString("Message");
+    schema.writeByte(2);
+    schema.writeVarUint(3);
+    schema.writeString("a");
+    schema.writeVarInt(-3);
+    schema.writeByte(0);
+    schema.writeVarUint(id);
+    schema.writeString("b");
+    schema.writeVarInt(-6);
+    schema.writeByte(1);
+    schema.writeVarUint(1);
+    schema.writeString("c");
+    schema.writeVarInt(-6);
+    schema.writeByte(0);
+    schema.writeVarUint(id);
+
+    kiwi::BinarySchema test_schema;
+    kiwi::ByteBuffer in(schema.data(), schema.size());
+    assert(test_schema.parse(in));
+
+    uint8_t data[] = {128, 1, 2, 'x', 0, 'y', 0};
+    kiwi::ByteBuffer bb(data, sizeof(data));
+    assert(test_schema.skipField(bb, 0, id) && bb.index() == 2);
+    assert(test_schema.skipField(bb, 0, 1) && bb.index() == sizeof(data));
+    assert(!test_schema.skipField(bb, 0, 3));
+    assert(!test_schema.skipField(bb, 0, id + 1));
+    assert(!test_schema.skipField(bb, 1, 1));
   }
 
   test1::BinarySchema test1_schema1;
@@ -740,6 +809,19 @@ static void testBinarySchema() {
     assert(test2_schema2.parse(file));
   }
 
+  // Only definitions that are exactly the same in both schemas are identical
+  assert(test1_schema1.isIdentical() && test1_schema1.isIdentical("Struct") && test1_schema1.isIdentical("Message"));
+  assert(!test1_schema2.isIdentical() && test1_schema2.isIdentical("Struct") && !test1_schema2.isIdentical("Message"));
+  assert(!test2_schema1.isIdentical() && test2_schema1.isIdentical("Struct") && !test2_schema1.isIdentical("Struct2"));
+  assert(test2_schema2.isIdentical() && test2_schema2.isIdentical("Message2") && !test2_schema2.isIdentical("Missing"));
+
+  {
+    uint32_t index = 0, hash1 = 0, hash2 = 0;
+    assert(test1_schema1.underlyingSchema().findDefinition("Struct", index) && test1_schema1.underlyingSchema().definitionHash(index, hash1));
+    assert(test2_schema2.underlyingSchema().findDefinition("Struct", index) && test2_schema2.underlyingSchema().definitionHash(index, hash2));
+    assert(hash1 == hash2 && !test2_schema2.underlyingSchema().definitionHash(100, hash2));
+  }
+
   auto check1 = [](const std::vector<uint8_t> &i, test1::BinarySchema *schema, const std::vector<uint8_t> &o) {
     kiwi::MemoryPool pool;
     kiwi::ByteBuffer bb(i.data(), i.size());
@@ -824,6 +906,294 @@ static void testBinarySchema() {
   OP ## _10(110, 111, 112, 113, 114, 115, 116, 117, 118, 119); \
   OP ## _10(120, 121, 122, 123, 124, 125, 126, 127, 128, 129); \
 
+static void testDynamicDecode() {
+  puts("testDynamicDecode");
+
+  kiwi::BinarySchema schema;
+  kiwi::ByteBuffer file;
+  assert(readFile("test-schema.bkiwi", file));
+  assert(schema.parse(file));
+
+  kiwi::MemoryPool pool;
+  kiwi::ByteBuffer bb;
+  test::NonDeprecatedMessage message;
+  message.set_g(9);
+  message.set_a(1);
+  message.set_c(pool, 3).set({3, 4, 5});
+  message.set_e(pool.allocate<test::ByteStruct>());
+  message.e()->set_x(123);
+  assert(message.encode(bb));
+
+  // Objects only contain the fields that are present, sorted by name
+  uint32_t index = 0;
+  kiwi::Value value;
+  assert(schema.findDefinition("NonDeprecatedMessage", index));
+  assert(schema.decode(bb, index, value, pool) && bb.index() == bb.size());
+  assert(value.kind() == kiwi::Value::OBJECT && value.typeName() == kiwi::String("NonDeprecatedMessage"));
+  assert(value.size() == 4);
+  assert(value.member(0).name == kiwi::String("a") && value.member(0).value.asUint() == 1);
+  assert(value.member(1).name == kiwi::String("c") && value.member(1).value.kind() == kiwi::Value::ARRAY);
+  assert(value.member(2).name == kiwi::String("e") && value.member(2).value.typeName() == kiwi::String("ByteStruct"));
+  assert(value.member(3).name == kiwi::String("g") && value.member(3).value.asUint() == 9);
+
+  const kiwi::Value *c = value.find("c");
+  assert(c && c->size() == 3 && (*c)[0].asUint() == 3 && (*c)[2].asUint() == 5 && !c->find("c"));
+  const kiwi::Value *e = value.find("e");
+  assert(e && e->find("x") && e->find("x")->asByte() == 123);
+  assert(!value.find("b") && !value.find("") && !value.find("z"));
+
+  // Accessors for the wrong kind return zero values
+  assert(value.asUint() == 0 && !value.asBool() && value.asString().size() == 0);
+  assert(value.find("a")->asInt() == 0 && value.find("a")->typeName().c_str() == nullptr);
+
+  // Enums are decoded by name
+  kiwi::ByteBuffer bb2;
+  test::EnumStruct enumStruct;
+  enumStruct.set_x(test::Enum::B);
+  enumStruct.set_y(pool, 2).set({test::Enum::A, test::Enum::B});
+  assert(enumStruct.encode(bb2));
+  assert(schema.findDefinition("EnumStruct", index));
+  kiwi::ByteBuffer in2(bb2.data(), bb2.size());
+  assert(schema.decode(in2, index, value, pool));
+  const kiwi::Value *x = value.find("x");
+  assert(x && x->kind() == kiwi::Value::ENUM && x->typeName() == kiwi::String("Enum") && x->enumName() == kiwi::String("B"));
+  assert(value.find("y")->size() == 2 && (*value.find("y"))[0].enumName() == kiwi::String("A"));
+
+  // Strings are copied into the pool
+  kiwi::ByteBuffer bb3;
+  test::StringStruct stringStruct;
+  stringStruct.set_x(pool.string("hello"));
+  assert(stringStruct.encode(bb3));
+  assert(schema.findDefinition("StringStruct", index));
+  kiwi::ByteBuffer in3(bb3.data(), bb3.size());
+  assert(schema.decode(in3, index, value, pool));
+  assert(value.find("x")->asString() == kiwi::String("hello") && value.find("x")->asString().c_str() != (const char *)bb3.data());
+
+  // Invalid data fails to decode
+  for (size_t size = 0; size < bb2.size(); size++) {
+    kiwi::ByteBuffer truncated(bb2.data(), size);
+    assert(!schema.decode(truncated, index, value, pool));
+  }
+  uint8_t badEnum[] = {1, 0};
+  kiwi::ByteBuffer in4(badEnum, sizeof(badEnum));
+  assert(schema.findDefinition("EnumStruct", index));
+  assert(!schema.decode(in4, index, value, pool));
+  assert(schema.findDefinition("Enum", index));
+  assert(!schema.decode(in4, index, value, pool));
+  uint8_t hugeArray[] = {200, 0, 255, 255, 255, 255, 15, 1, 2};
+  kiwi::ByteBuffer in5(hugeArray, sizeof(hugeArray));
+  assert(schema.findDefinition("EnumStruct", index));
+  assert(!schema.decode(in5, index, value, pool));
+
+  // Recursion is bounded by the maximum depth
+  std::vector<uint8_t> deep(2000, 1);
+  deep.resize(4001, 0);
+  assert(schema.findDefinition("RecursiveMessage", index));
+  kiwi::ByteBuffer in6(deep.data(), deep.size());
+  assert(!schema.decode(in6, index, value, pool));
+  schema.setMaxDepth(10);
+  std::vector<uint8_t> shallow(10, 1);
+  shallow.resize(21, 0);
+  kiwi::ByteBuffer in7(shallow.data(), shallow.size());
+  assert(!schema.decode(in7, index, value, pool));
+  schema.setMaxDepth(11);
+  kiwi::ByteBuffer in8(shallow.data(), shallow.size());
+  assert(schema.decode(in8, index, value, pool) && in8.index() == shallow.size());
+  assert(value.find("x") && value.find("x")->find("x") && !value.find("x")->find("x")->find("y"));
+
+  // Decoding recurses, so it has its own limit even if skipping can go deeper
+  schema.setMaxDepth(2000000);
+  deep.assign(1000000, 1);
+  deep.resize(2000001, 0);
+  kiwi::ByteBuffer in9(deep.data(), deep.size());
+  assert(!schema.decode(in9, index, value, pool));
+  deep.assign(kiwi::BinarySchema::MAX_DECODE_DEPTH - 1, 1);
+  deep.resize(kiwi::BinarySchema::MAX_DECODE_DEPTH * 2 - 1, 0);
+  kiwi::ByteBuffer in10(deep.data(), deep.size());
+  assert(schema.decode(in10, index, value, pool) && in10.index() == deep.size());
+
+  // Empty structs take no input, so arrays of them are limited in length
+  kiwi::ByteBuffer emptySchema;
+  emptySchema.writeVarUint(2);
+  emptySchema.writeString("Empty");
+  emptySchema.writeByte(1);
+  emptySchema.writeVarUint(0);
+  emptySchema.writeString("Holder");
+  emptySchema.writeByte(1);
+  emptySchema.writeVarUint(1);
+  emptySchema.writeString("x");
+  emptySchema.writeVarInt(0);
+  emptySchema.writeByte(1);
+  emptySchema.writeVarUint(0);
+  kiwi::BinarySchema empty;
+  kiwi::ByteBuffer in11(emptySchema.data(), emptySchema.size());
+  assert(empty.parse(in11) && empty.findDefinition("Holder", index));
+  uint8_t emptyArrays[][5] = {{3}, {128, 2}, {129, 2}, {255, 255, 255, 255, 15}};
+  for (auto &bytes : emptyArrays) {
+    kiwi::ByteBuffer in12(bytes, sizeof(bytes));
+    bool success = empty.decode(in12, index, value, pool);
+    assert(success == (bytes[0] == 3 || bytes[0] == 128));
+    assert(!success || value.find("x")->size() == (bytes[0] == 3 ? 3 : 256));
+  }
+}
+
+static void testSkipDepth() {
+  puts("testSkipDepth");
+
+  kiwi::BinarySchema schema;
+  kiwi::ByteBuffer file;
+  uint32_t index = 0;
+  assert(readFile("test-schema.bkiwi", file));
+  assert(schema.parse(file));
+  assert(schema.findDefinition("RecursiveMessage", index));
+
+  // Skipping field "x" of a RecursiveMessage nested "depth" levels deep
+  auto check = [&](uint32_t depth) {
+    std::vector<uint8_t> bytes(depth - 1, 1);
+    bytes.resize(depth * 2 - 1, 0);
+    kiwi::ByteBuffer bb(bytes.data(), bytes.size());
+    bool success = schema.skipField(bb, index, 1);
+    assert(!success || bb.index() == bytes.size());
+    return success;
+  };
+
+  assert(check(1));
+  assert(check(100));
+  assert(check(schema.maxDepth()));
+  assert(!check(schema.maxDepth() + 1));
+
+  // Hostile depth fails cleanly instead of overflowing the stack
+  assert(!check(1000000));
+
+  schema.setMaxDepth(10);
+  assert(check(10) && !check(11));
+
+  // The stack lives in a pool, so very deep input can be allowed
+  schema.setMaxDepth(2000000);
+  assert(check(1000000));
+}
+
+static void testSchemaCache() {
+  puts("testSchemaCache");
+
+  kiwi::ByteBuffer file1;
+  kiwi::ByteBuffer file2;
+  assert(readFile("test1-schema.bkiwi", file1));
+  assert(readFile("test2-schema.bkiwi", file2));
+
+  {
+    // The same bytes share one parsed schema, even when they're in a different buffer
+    std::vector<uint8_t> copy(file1.data(), file1.data() + file1.size());
+    std::shared_ptr<const test1::BinarySchema> a = kiwi::SchemaCache<test1::BinarySchema>::parse(file1.data(), file1.size());
+    std::shared_ptr<const test1::BinarySchema> b = kiwi::SchemaCache<test1::BinarySchema>::parse(copy.data(), copy.size());
+    std::shared_ptr<const test1::BinarySchema> c = kiwi::SchemaCache<test1::BinarySchema>::parse(file2.data(), file2.size());
+    assert(a && a == b && c && c != a);
+    assert(a->isIdentical() && !c->isIdentical());
+    assert(kiwi::SchemaCache<test1::BinarySchema>::size() == 2);
+
+    // Each schema type has its own cache
+    std::shared_ptr<const kiwi::BinarySchema> d = kiwi::SchemaCache<kiwi::BinarySchema>::parse(file1.data(), file1.size());
+    uint32_t index = 0;
+    assert(d && d->findDefinition("Message", index));
+    assert(kiwi::SchemaCache<kiwi::BinarySchema>::size() == 1);
+
+    // Cached schemas can be used for decoding
+    std::vector<uint8_t> bytes{1, 2, 2, 128, 0, 0, 0, 128, 0, 0, 128, 3, 1, 0, 4, 0, 5, 1, 240, 159, 141, 149, 0, 0, 0};
+    kiwi::MemoryPool pool;
+    kiwi::ByteBuffer bb(bytes.data(), bytes.size());
+    test1::Message message;
+    assert(message.decode(bb, pool, c.get()));
+
+    // Invalid schemas aren't cached
+    uint8_t invalid[] = {1};
+    assert(!kiwi::SchemaCache<test1::BinarySchema>::parse(invalid, sizeof(invalid)));
+    assert(kiwi::SchemaCache<test1::BinarySchema>::size() == 2);
+  }
+
+  // Schemas are freed when they're no longer used
+  assert(kiwi::SchemaCache<test1::BinarySchema>::size() == 0);
+  assert(kiwi::SchemaCache<kiwi::BinarySchema>::size() == 0);
+}
+
+static void testSkipStructs() {
+  puts("testSkipStructs");
+
+  kiwi::ByteBuffer schema;
+  auto definition = [&](const char *name, uint8_t kind, uint32_t fieldCount) {
+    schema.writeString(name);
+    schema.writeByte(kind);
+    schema.writeVarUint(fieldCount);
+  };
+  auto field = [&](const char *name, int32_t type, bool isArray, uint32_t value) {
+    schema.writeString(name);
+    schema.writeVarInt(type);
+    schema.writeByte(isArray);
+    schema.writeVarUint(value);
+  };
+
+  schema.writeVarUint(5);
+  definition("Color", 1, 4);
+  field("r", -2, false, 0);
+  field("g", -2, false, 0);
+  field("b", -2, false, 0);
+  field("a", -2, false, 0);
+  definition("Point", 1, 2);
+  field("x", -5, false, 0);
+  field("y", -5, false, 0);
+  definition("Mixed", 1, 7);
+  field("c", 0, false, 0);
+  field("n", -4, false, 0);
+  field("m", -3, false, 0);
+  field("p", 1, false, 0);
+  field("s", -6, false, 0);
+  field("big", -7, false, 0);
+  field("flags", -1, true, 0);
+  definition("Message", 2, 3);
+  field("colors", 0, true, 1);
+  field("points", 1, true, 2);
+  field("mixed", 2, true, 3);
+  definition("Recursive", 1, 1);
+  field("self", 4, false, 0);
+
+  kiwi::BinarySchema binarySchema;
+  kiwi::ByteBuffer in(schema.data(), schema.size());
+  assert(binarySchema.parse(in));
+
+  auto check = [&](uint32_t id, kiwi::ByteBuffer &bb) {
+    for (size_t size = 0; size < bb.size(); size++) {
+      kiwi::ByteBuffer truncated(bb.data(), size);
+      assert(!binarySchema.skipField(truncated, 3, id));
+    }
+    kiwi::ByteBuffer complete(bb.data(), bb.size());
+    assert(binarySchema.skipField(complete, 3, id) && complete.index() == bb.size());
+  };
+
+  kiwi::ByteBuffer colors;
+  colors.writeVarUint(20);
+  for (uint32_t i = 0; i < 80; i++) colors.writeByte(i);
+  check(1, colors);
+
+  kiwi::ByteBuffer points;
+  points.writeVarUint(10);
+  for (uint32_t i = 0; i < 20; i++) points.writeVarFloat(i % 3 ? i * 0.5f : 0);
+  check(2, points);
+
+  kiwi::ByteBuffer mixed;
+  mixed.writeVarUint(12);
+  for (uint32_t i = 0; i < 12; i++) {
+    for (uint32_t j = 0; j < 4; j++) mixed.writeByte(i + j);
+    mixed.writeVarUint(i * 1000);
+    mixed.writeVarInt(-(int32_t)i);
+    mixed.writeVarFloat(i);
+    mixed.writeVarFloat(0);
+    mixed.writeString(i % 2 ? "abc" : "");
+    mixed.writeVarInt64(-(int64_t)i << 40);
+    mixed.writeVarUint(i % 3);
+    for (uint32_t j = 0; j < i % 3; j++) mixed.writeByte(1);
+  }
+  check(3, mixed);
+}
+
 static void testLargeStruct() {
   puts("testLargeStruct");
 
@@ -916,6 +1286,799 @@ static void testDeprecatedFields() {
   assert(*nonDeprecated2.g() == 9);
 }
 
+static void testBorrowedStrings() {
+  puts("testBorrowedStrings");
+
+  kiwi::ByteBuffer bb;
+  kiwi::MemoryPool pool;
+
+  test::StringArrayMessage message;
+  auto &x = message.set_x(pool, 3);
+  x[0] = pool.string("abc");
+  x[1] = pool.string("");
+  x[2] = pool.string("🙉🙈🙊");
+  assert(message.encode(bb));
+
+  // Borrowed strings point into the input instead of being copied into the pool
+  kiwi::ByteBuffer bb2(bb.data(), bb.size());
+  test::StringArrayMessage message2;
+  assert(message2.decodeBorrowed(bb2, pool));
+  assert(message2.x());
+  assert(message2.x()->size() == 3);
+  for (uint32_t i = 0; i < 3; i++) {
+    const kiwi::String &value = (*message2.x())[i];
+    assert(value == x[i]);
+    assert(value.c_str() > reinterpret_cast<const char *>(bb.data()));
+    assert(value.c_str() + value.size() < reinterpret_cast<const char *>(bb.data() + bb.size()));
+  }
+
+  // Regular decoding still copies strings into the pool
+  kiwi::ByteBuffer bb3(bb.data(), bb.size());
+  test::StringArrayMessage message3;
+  assert(message3.decode(bb3, pool));
+  assert((*message3.x())[0] == x[0]);
+  assert((*message3.x())[0].c_str() != (*message2.x())[0].c_str());
+}
+
+// Encodes after some other output into a buffer with exactly enough room left
+template <typename T>
+static bool encodesInReservation(T &value, size_t before) {
+  kiwi::ByteBuffer bb;
+  bb.reserve(before + value.encodedSize());
+  uint8_t *data = bb.data();
+  for (size_t i = 0; i < before; i++) bb.writeByte(0);
+  return value.encode(bb) && bb.size() == before + value.encodedSize() && bb.data() == data;
+}
+
+static void testEncodedSize() {
+  puts("testEncodedSize");
+
+  kiwi::MemoryPool pool;
+
+  test::SortedStruct s;
+  s.set_a1(true);
+  s.set_b1(123);
+  s.set_c1(-12345);
+  s.set_d1(12345);
+  s.set_e1(123.45);
+  s.set_f1(pool.string("abcde"));
+  s.set_g1(-123456789012345678);
+  s.set_h1(123456789012345678);
+  s.set_a2(false);
+  s.set_b2(0);
+  s.set_c2(0);
+  s.set_d2(0xFFFFFFFF);
+  s.set_e2(0);
+  s.set_f2(pool.string(""));
+  s.set_g2(0);
+  s.set_h2(0xFFFFFFFFFFFFFFFF);
+  s.set_a3(pool, 2).set({false, true});
+  s.set_b3(pool, 3).set({1, 2, 3});
+  // Large enough to outgrow the initial capacity, and mostly single-byte
+  // varints so a worst-case sized write would not fit in the reservation
+  kiwi::Array<int32_t> &c3 = s.set_c3(pool, 1000);
+  for (uint32_t i = 0; i < c3.size(); i++) c3[i] = i % 2 ? -1000 : i % 32;
+  c3[0] = 1 << 30;
+  s.set_d3(pool, 2).set({1000, 0});
+  s.set_e3(pool, 2).set({0.1f, 0});
+  s.set_f3(pool, 2).set({pool.string(""), pool.string("xyz")});
+  s.set_g3(pool, 1).set({-123456789012345678});
+  s.set_h3(pool, 1).set({123456789012345678});
+
+  kiwi::ByteBuffer bb;
+  bb.reserve(s.encodedSize());
+  uint8_t *data = bb.data();
+  assert(s.encode(bb));
+  assert(bb.size() == s.encodedSize());
+  assert(bb.data() == data);
+
+  test::NonDeprecatedMessage m;
+  m.set_a(1 << 20);
+  m.set_c(pool, 3).set({3, 400, 5});
+  m.set_e(pool.allocate<test::ByteStruct>());
+  m.e()->set_x(123);
+
+  kiwi::ByteBuffer bb2;
+  assert(m.encode(bb2));
+  assert(bb2.size() == m.encodedSize());
+
+  // The final writes of messages and structs only take the room they need
+  m.set_c(pool, 400);
+  assert(encodesInReservation(m, 0));
+  test::CompoundStruct compound;
+  compound.set_x(1);
+  compound.set_y(2);
+  assert(encodesInReservation(compound, 300));
+  test::NestedStruct nested;
+  nested.set_a(1);
+  nested.set_b(&compound);
+  nested.set_c(3);
+  assert(encodesInReservation(nested, 300));
+  test::FloatStruct floats;
+  floats.set_x(0);
+  assert(encodesInReservation(floats, 300));
+  test::Uint64Struct uint64s;
+  uint64s.set_x(1);
+  assert(encodesInReservation(uint64s, 300));
+
+  test::BoolMessage empty;
+  assert(empty.encodedSize() == 1);
+}
+
+static void testUncheckedWrites() {
+  puts("testUncheckedWrites");
+
+  kiwi::ByteBuffer bb;
+  bb.writeByte(1);
+  bb.writeVarFloat(0.5);
+  bb.writeVarUint(0xFFFFFFFF);
+  bb.writeVarInt(-12345);
+  bb.writeVarUint64(0xFFFFFFFFFFFFFFFF);
+  bb.writeVarInt64(-123456789012345678);
+
+  // Writing through a cursor must produce the same bytes as the checked writers
+  kiwi::ByteBuffer bb2;
+  bb2.writeByte(1);
+  uint8_t *out = bb2.beginWrite(4 + 5 + 5 + 9 + 9);
+  kiwi::ByteBuffer::putVarFloat(out, 0.5);
+  kiwi::ByteBuffer::putVarUint(out, 0xFFFFFFFF);
+  kiwi::ByteBuffer::putVarInt(out, -12345);
+  kiwi::ByteBuffer::putVarUint64(out, 0xFFFFFFFFFFFFFFFF);
+  kiwi::ByteBuffer::putVarInt64(out, -123456789012345678);
+  bb2.endWrite(out);
+
+  assert(std::vector<uint8_t>(bb.data(), bb.data() + bb.size()) == std::vector<uint8_t>(bb2.data(), bb2.data() + bb2.size()));
+}
+
+static void testSegmentedBuffer() {
+  puts("testSegmentedBuffer");
+
+  // Same layout as "struct iovec" without depending on a POSIX header
+  struct IOVec {
+    void *iov_base;
+    size_t iov_len;
+  };
+
+  kiwi::MemoryPool pool;
+  std::vector<uint8_t> bytes(1000);
+  for (size_t i = 0; i < bytes.size(); i++) bytes[i] = i * 7;
+
+  test::StringArrayMessage message;
+  auto &x = message.set_x(pool, 100);
+  for (auto &it : x) it = pool.string("abcdefghijklmnopqrstuvwxyz");
+
+  kiwi::ByteBuffer bb;
+  kiwi::ByteBuffer bb2;
+  bb2.setSegmentSize(64);
+  for (int i = 0; i < 3; i++) {
+    assert(message.encode(bb));
+    assert(message.encode(bb2));
+    bb.writeBytes(bytes.data(), bytes.size());
+    bb2.writeBytes(bytes.data(), bytes.size());
+  }
+  assert(bb2.size() == bb.size());
+
+  // Gathering the segments back together must give the contiguous output
+  std::vector<IOVec> segments(bb2.segmentCount());
+  assert(segments.size() > 1);
+  assert(bb2.segments(segments.data(), segments.size()) == segments.size());
+  std::vector<uint8_t> joined;
+  for (auto &segment : segments) {
+    assert(segment.iov_len > 0);
+    joined.insert(joined.end(), (uint8_t *)segment.iov_base, (uint8_t *)segment.iov_base + segment.iov_len);
+  }
+  assert(joined == std::vector<uint8_t>(bb.data(), bb.data() + bb.size()));
+}
+
+static void testStreamingInput() {
+  puts("testStreamingInput");
+
+  struct Input {
+    const std::vector<uint8_t> *bytes;
+    size_t index;
+  };
+
+  kiwi::MemoryPool pool;
+  test::StringArrayMessage strings;
+  auto &x = strings.set_x(pool, 50);
+  for (auto &it : x) it = pool.string("abcdefghijklmnopqrstuvwxyz");
+
+  test::ByteArrayMessage bytes;
+  auto &y = bytes.set_x(pool, 1000);
+  for (uint32_t i = 0; i < y.size(); i++) y[i] = i * 7;
+
+  test::UintArrayStruct uints;
+  auto &z = uints.set_x(pool, 1000);
+  for (uint32_t i = 0; i < z.size(); i++) z[i] = i * i;
+
+  kiwi::ByteBuffer bb;
+  assert(strings.encode(bb));
+  assert(bytes.encode(bb));
+  assert(uints.encode(bb));
+  std::vector<uint8_t> o(bb.data(), bb.data() + bb.size());
+
+  // Deliver the input a few bytes at a time to hit every refill boundary
+  Input input{&o, 0};
+  kiwi::ByteBuffer bb2;
+  bb2.setSource([](void *context, uint8_t *data, size_t size) -> size_t {
+    Input &input = *static_cast<Input *>(context);
+    size_t count = input.bytes->size() - input.index;
+    if (count > size) count = size;
+    if (count > 3) count = 1 + input.index % 3;
+    memcpy(data, input.bytes->data() + input.index, count);
+    input.index += count;
+    return count;
+  }, &input, 16);
+
+  test::StringArrayMessage strings2;
+  test::ByteArrayMessage bytes2;
+  test::UintArrayStruct uints2;
+  assert(strings2.decode(bb2, pool));
+  assert(bytes2.decode(bb2, pool));
+  assert(uints2.decode(bb2, pool));
+  assert(bb2.index() == o.size());
+
+  kiwi::ByteBuffer bb3;
+  assert(strings2.encode(bb3));
+  assert(bytes2.encode(bb3));
+  assert(uints2.encode(bb3));
+  assert(std::vector<uint8_t>(bb3.data(), bb3.data() + bb3.size()) == o);
+
+  // The end of the input is an error in the middle of a value
+  uint8_t dummy;
+  assert(!bb2.readByte(dummy));
+
+  // Read a file directly instead of loading it into memory first
+  FILE *f = fopen("test-schema.bkiwi", "rb");
+  assert(f);
+  kiwi::ByteBuffer file;
+  file.setSource(f, 64);
+  kiwi::BinarySchema schema;
+  assert(schema.parse(file));
+  fclose(f);
+}
+
+static void testMappedFile() {
+#ifdef KIWI_HAS_FILE_DESCRIPTORS
+  puts("testMappedFile");
+
+  kiwi::ByteBuffer missing;
+  assert(!missing.mapFile("missing-file.bkiwi"));
+
+  // Only regular files with their actual size can be mapped
+  kiwi::ByteBuffer device;
+  assert(!device.mapFile("/dev/null"));
+  kiwi::ByteBuffer directory;
+  assert(!directory.mapFile("."));
+  kiwi::ByteBuffer procfs;
+  assert(!procfs.mapFile("/proc/self/status"));
+
+  kiwi::ByteBuffer file;
+  kiwi::ByteBuffer mapped;
+  assert(readFile("test-schema.bkiwi", file));
+  assert(mapped.mapFile("test-schema.bkiwi", true));
+  assert(mapped.size() == file.size());
+  assert(!memcmp(mapped.data(), file.data(), file.size()));
+
+  kiwi::BinarySchema schema;
+  assert(schema.parse(mapped));
+#endif
+}
+
+static void testMemoryPool() {
+  puts("testMemoryPool");
+
+  kiwi::MemoryPool pool(64, 256);
+
+  // A large allocation gets its own chunk without abandoning the current one
+  uint32_t *a = pool.allocate<uint32_t>(4);
+  uint8_t *large = pool.allocate<uint8_t>(1000);
+  uint32_t *b = pool.allocate<uint32_t>(4);
+  assert(b == a + 4);
+  for (int i = 0; i < 1000; i++) assert(large[i] == 0);
+
+  // Chunks grow up to the maximum capacity and everything stays zero-initialized
+  std::vector<uint32_t *> pointers;
+  for (uint32_t i = 0; i < 1000; i++) {
+    uint32_t *p = pool.allocate<uint32_t>(i % 20 + 1);
+    for (uint32_t j = 0; j <= i % 20; j++) {
+      assert(p[j] == 0);
+      p[j] = i;
+    }
+    pointers.push_back(p);
+  }
+  for (uint32_t i = 0; i < 1000; i++) {
+    for (uint32_t j = 0; j <= i % 20; j++) assert(pointers[i][j] == i);
+  }
+
+  pool.clear();
+  uint64_t *first = pool.allocate<uint64_t>(3);
+  assert(first[2] == 0);
+
+  // Resetting reuses the same chunks and zeroes them again
+  uint32_t *c = pool.allocate<uint32_t>(4);
+  c[3] = 123;
+  pool.allocate<uint8_t>(1000);
+  for (int i = 0; i < 100; i++) pool.allocate<uint32_t>(10);
+  pool.reset();
+  uint64_t *d = pool.allocate<uint64_t>(3);
+  assert(d == first);
+  uint32_t *e = pool.allocate<uint32_t>(4);
+  assert(e == c && e[3] == 0);
+
+  // Uninitialized allocations come from the same chunk
+  uint32_t *f = pool.allocateUninitialized<uint32_t>(4);
+  assert(f == e + 4);
+  kiwi::Array<uint32_t> g = pool.array(f, 0);
+  f[0] = 1, f[1] = 2;
+  kiwi::Array<uint32_t> h = pool.array(f, 2);
+  assert(g.size() == 0 && h.size() == 2 && h.data() == f + 4 && h[0] == 1 && h[1] == 2);
+
+  // Trimming keeps only the chunks that fit
+  pool.reset(64);
+  assert(pool.allocate<uint64_t>(3) == first);
+  pool.reset(0);
+  assert(pool.allocate<uint32_t>(4)[3] == 0);
+}
+
+struct CountingAllocator : kiwi::Allocator {
+  size_t allocations = 0;
+  size_t outstanding = 0;
+  size_t peak = 0;
+
+  void *allocate(size_t size) override {
+    allocations++;
+    outstanding += size;
+    if (peak < outstanding) peak = outstanding;
+    return malloc(size);
+  }
+
+  void free(void *data, size_t size) override {
+    assert(outstanding >= size);
+    outstanding -= size;
+    ::free(data);
+  }
+};
+
+static void testAllocator() {
+  puts("testAllocator");
+
+  CountingAllocator allocator;
+
+  {
+    kiwi::ByteBuffer bb(&allocator);
+    for (uint32_t i = 0; i < 1000; i++) bb.writeVarUint(i * 1000);
+    assert(allocator.allocations > 1 && allocator.outstanding >= bb.size());
+
+    kiwi::MemoryPool pool(&allocator);
+    kiwi::ByteBuffer in(bb.data(), bb.size());
+    kiwi::Array<uint32_t> values = pool.array<uint32_t>(1000);
+    assert(in.readVarUintArray(values.data(), values.size()));
+    for (uint32_t i = 0; i < 1000; i++) assert(values[i] == i * 1000);
+    pool.allocate<uint8_t>(100000);
+    pool.reset(0);
+    pool.allocate<uint8_t>(10);
+  }
+
+  {
+    kiwi::ByteBuffer bb(&allocator);
+    bb.setSegmentSize(64);
+    for (uint32_t i = 0; i < 1000; i++) bb.writeVarUint(i);
+    assert(bb.segmentCount() > 1);
+  }
+
+  assert(allocator.outstanding == 0);
+}
+
+static void testStreamingWindow() {
+  puts("testStreamingWindow");
+
+  struct Input {
+    std::vector<uint8_t> bytes;
+    size_t index;
+  };
+
+  auto source = [](void *context, uint8_t *data, size_t size) -> size_t {
+    Input &input = *static_cast<Input *>(context);
+    size_t count = input.bytes.size() - input.index;
+    if (count > size) count = size;
+    memcpy(data, input.bytes.data() + input.index, count);
+    input.index += count;
+    return count;
+  };
+
+  Input input{{}, 0};
+  kiwi::ByteBuffer bb;
+  bb.writeVarUint(1 << 20);
+  for (uint32_t i = 0; i < 1 << 20; i++) bb.writeByte(i);
+  bb.writeByte(123);
+  bb.writeVarUint(1 << 16);
+  for (uint32_t i = 0; i < 1 << 16; i++) bb.writeByte(i);
+  bb.writeByte(234);
+  input.bytes.assign(bb.data(), bb.data() + bb.size());
+
+  // Skipping bytes reads them a window at a time
+  CountingAllocator allocator;
+  {
+    kiwi::ByteBuffer stream(&allocator);
+    stream.setSource(source, &input, 4096);
+    uint32_t count;
+    uint8_t value;
+    assert(stream.readVarUint(count) && count == 1 << 20);
+    assert(stream.skipBytes(count));
+    assert(stream.readByte(value) && value == 123);
+    assert(allocator.peak < 2 * 4096);
+
+    // Reading more than a window grows it, and it shrinks back afterward
+    const uint8_t *bytes;
+    assert(stream.readVarUint(count) && count == 1 << 16);
+    assert(stream.readBytes(bytes, count));
+    for (uint32_t i = 0; i < count; i++) assert(bytes[i] == (uint8_t)i);
+    assert(allocator.outstanding >= 1 << 16);
+    assert(stream.readByte(value) && value == 234);
+    assert(allocator.outstanding <= 4096);
+    assert(!stream.readByte(value));
+  }
+  assert(allocator.outstanding == 0);
+
+  // A hostile length doesn't allocate more than the input actually contains
+  input.bytes.assign({0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 1, 2, 3});
+  input.index = 0;
+  allocator.peak = 0;
+  {
+    kiwi::ByteBuffer stream(&allocator);
+    stream.setSource(source, &input, 4096);
+    uint32_t count;
+    const uint8_t *bytes;
+    assert(stream.readVarUint(count) && count == UINT32_MAX);
+    assert(!stream.readBytes(bytes, count));
+    assert(allocator.peak < 2 * 4096);
+  }
+}
+
+static void testInlineMemoryPool() {
+  puts("testInlineMemoryPool");
+
+  CountingAllocator allocator;
+
+  {
+    kiwi::InlineMemoryPool<256> pool(&allocator);
+    const uint8_t *begin = reinterpret_cast<const uint8_t *>(&pool);
+    const uint8_t *end = begin + sizeof(pool);
+
+    // Small allocations come from inside the pool object
+    uint64_t *a = pool.allocate<uint64_t>(16);
+    kiwi::String b = pool.string("abc");
+    assert(reinterpret_cast<uint8_t *>(a) >= begin && reinterpret_cast<const uint8_t *>(b.c_str()) + 4 <= end);
+    assert(a[15] == 0 && b == kiwi::String("abc") && allocator.allocations == 0);
+
+    // Everything else falls back to the heap
+    pool.allocate<uint64_t>(16);
+    pool.allocate<uint8_t>(10000);
+    assert(allocator.allocations == 2);
+
+    // The inline chunk survives both clear() and reset()
+    pool.reset(0);
+    assert(pool.allocate<uint64_t>(16) == a && allocator.outstanding == 0);
+    pool.allocate<uint64_t>(16);
+    pool.clear();
+    assert(pool.allocate<uint64_t>(16) == a && allocator.outstanding == 0);
+    pool.allocate<uint64_t>(16);
+  }
+
+  assert(allocator.outstanding == 0);
+
+  // Generated code takes a plain MemoryPool
+  kiwi::InlineMemoryPool<1024> pool;
+  kiwi::ByteBuffer bb;
+  test::StringMessage message;
+  message.set_x(pool.string("hello"));
+  assert(message.encode(bb));
+  kiwi::ByteBuffer in(bb.data(), bb.size());
+  test::StringMessage decoded;
+  assert(decoded.decode(in, pool) && *decoded.x() == kiwi::String("hello"));
+}
+
+static void testFailedArrayDecode() {
+  puts("testFailedArrayDecode");
+
+  kiwi::MemoryPool pool;
+  test::NonDeprecatedMessage message;
+  auto &c = message.set_c(pool, 100);
+  for (uint32_t i = 0; i < c.size(); i++) c[i] = 1000 + i;
+  auto &d = message.set_d(pool, 100);
+  for (uint32_t i = 0; i < d.size(); i++) d[i] = 2000 + i;
+  kiwi::ByteBuffer bb;
+  assert(message.encode(bb));
+
+  // Fill the pool with old data, then reuse it for decoding truncated arrays
+  kiwi::MemoryPool decodePool;
+  uint32_t *old = decodePool.allocate<uint32_t>(1000);
+  for (uint32_t i = 0; i < 1000; i++) old[i] = 0xDEAD0000 + i;
+  for (size_t size : {(size_t)10, bb.size() - 5}) {
+    decodePool.reset();
+    kiwi::ByteBuffer truncated(bb.data(), size);
+    test::NonDeprecatedMessage decoded;
+    assert(!decoded.decode(truncated, decodePool));
+    assert(size == 10 ? !decoded.c() : decoded.c() && (*decoded.c())[99] == 1099);
+    assert(!decoded.d());
+  }
+}
+
+static void testMemoryPoolRollback() {
+  puts("testMemoryPoolRollback");
+
+  CountingAllocator allocator;
+
+  {
+    kiwi::MemoryPool pool(64, 256, &allocator);
+
+    // Rolling back an empty pool keeps the chunks for reuse
+    kiwi::MemoryPool::Mark empty = pool.mark();
+    uint32_t *a = pool.allocate<uint32_t>(4);
+    pool.allocate<uint32_t>(100);
+    pool.rollback(empty);
+    assert(pool.allocate<uint32_t>(4) == a && allocator.outstanding > 0);
+
+    // Rolling back frees dedicated chunks and reuses the bump position
+    kiwi::MemoryPool::Mark mark = pool.mark();
+    size_t outstanding = allocator.outstanding;
+    uint32_t *b = pool.allocate<uint32_t>(4);
+    b[0] = 123;
+    pool.allocate<uint8_t>(1000);
+    for (int i = 0; i < 100; i++) pool.allocate<uint32_t>(10);
+    size_t allocations = allocator.allocations;
+    pool.rollback(mark);
+    assert(allocator.outstanding > outstanding);
+    uint32_t *c = pool.allocate<uint32_t>(4);
+    assert(c == b && c[0] == 0);
+
+    // The same amount of memory fits again without allocating more chunks
+    for (int i = 0; i < 100; i++) pool.allocate<uint32_t>(10);
+    assert(allocator.allocations == allocations);
+
+    // Repeated failed decodes don't grow the pool
+    kiwi::MemoryPool::Mark before = pool.mark();
+    outstanding = allocator.outstanding;
+    for (int i = 0; i < 100; i++) {
+      uint8_t truncated[] = {1, 'a', 'b'};
+      kiwi::ByteBuffer bb(truncated, sizeof(truncated));
+      test::StringMessage message;
+      assert(!message.decode(bb, pool));
+      pool.allocate<uint8_t>(1000);
+      pool.rollback(before);
+      assert(allocator.outstanding == outstanding);
+    }
+  }
+
+  assert(allocator.outstanding == 0);
+}
+
+static void testThreadCache() {
+  puts("testThreadCache");
+
+  // Chunks freed by one pool are reused by the next
+  uint8_t *first = nullptr;
+  {
+    kiwi::MemoryPool pool(kiwi::Allocator::threadCache());
+    first = pool.allocate<uint8_t>(100);
+    pool.allocate<uint8_t>(100000);
+  }
+  {
+    kiwi::MemoryPool pool(kiwi::Allocator::threadCache());
+    assert(pool.allocate<uint8_t>(100) == first);
+    assert(pool.allocate<uint8_t>(100)[99] == 0);
+  }
+
+  // Buffers can share the same cache
+  {
+    kiwi::ByteBuffer bb(kiwi::Allocator::threadCache());
+    for (uint32_t i = 0; i < 1000; i++) bb.writeVarUint(i);
+  }
+
+  // One-off sizes get recycled instead of keeping regular chunks out of the
+  // cache, which holds on to the chunk so nothing else can allocate it
+  kiwi::Allocator *cache = kiwi::Allocator::threadCache();
+  for (size_t i = 0; i < 32; i++) cache->free(cache->allocate(5000 + i * 16), 5000 + i * 16);
+  void *chunk = cache->allocate(4096);
+  cache->free(chunk, 4096);
+  void *other = malloc(4096);
+  assert(other != chunk);
+  assert(cache->allocate(4096) == chunk);
+  cache->free(chunk, 4096);
+  free(other);
+
+  // Memory over the capacity goes straight back to the upstream allocator
+  kiwi::Allocator::setThreadCacheCapacity(0);
+  {
+    kiwi::MemoryPool pool(kiwi::Allocator::threadCache());
+    pool.allocate<uint8_t>(100);
+  }
+  kiwi::Allocator::setThreadCacheCapacity(1 << 22);
+}
+
+#ifdef KIWI_STATISTICS
+static std::vector<kiwi::MemoryPoolStatistics> memoryPoolStatistics;
+static std::vector<kiwi::ByteBufferStatistics> byteBufferStatistics;
+
+static void testStatistics() {
+  puts("testStatistics");
+
+  kiwi::statisticsHooks().memoryPool = [](const kiwi::MemoryPoolStatistics &statistics) { memoryPoolStatistics.push_back(statistics); };
+  kiwi::statisticsHooks().byteBuffer = [](const kiwi::ByteBufferStatistics &statistics) { byteBufferStatistics.push_back(statistics); };
+
+  {
+    kiwi::MemoryPool pool(64, 256);
+    kiwi::MemoryPoolStatistics statistics = pool.statistics();
+    assert(statistics.chunks == 0 && statistics.reservedBytes == 0 && statistics.usedBytes == 0);
+
+    // Moving on to the next chunk wastes the rest of the current one
+    pool.allocate<uint8_t>(30);
+    pool.allocate<uint8_t>(30);
+    pool.allocate<uint8_t>(30);
+    statistics = pool.statistics();
+    assert(statistics.chunks == 2 && statistics.reservedBytes == 64 + 128);
+    assert(statistics.usedBytes == 90 && statistics.wastedBytes == 4);
+
+    // Dedicated chunks are used in full
+    pool.allocate<uint8_t>(1000);
+    statistics = pool.statistics();
+    assert(statistics.chunks == 3 && statistics.reservedBytes == 64 + 128 + 1000);
+    assert(statistics.usedBytes == 1090 && statistics.wastedBytes == 4);
+
+    // Peaks survive rollback() and reset()
+    kiwi::MemoryPool::Mark mark = pool.mark();
+    pool.allocate<uint8_t>(2000);
+    pool.rollback(mark);
+    statistics = pool.statistics();
+    assert(statistics.usedBytes == 1090 && statistics.peakUsedBytes == 3090);
+    assert(statistics.reservedBytes == 64 + 128 + 1000 && statistics.peakReservedBytes == 64 + 128 + 3000);
+
+    pool.reset();
+    statistics = pool.statistics();
+    assert(statistics.chunks == 2 && statistics.usedBytes == 0 && statistics.wastedBytes == 0);
+    assert(statistics.peakUsedBytes == 3090 && statistics.chunkAllocations == 4);
+  }
+
+  assert(memoryPoolStatistics.size() == 1 && memoryPoolStatistics[0].chunkAllocations == 4);
+
+  // Inline pools report everything they held when destroyed
+  {
+    kiwi::InlineMemoryPool<256> pool;
+    pool.allocate<uint8_t>(100);
+    pool.allocate<uint8_t>(1000);
+  }
+
+  assert(memoryPoolStatistics.size() == 2 && memoryPoolStatistics[1].chunkAllocations == 1);
+  assert(memoryPoolStatistics[1].usedBytes == 1100);
+
+  {
+    kiwi::ByteBuffer bb;
+    for (uint32_t i = 0; i < 1000; i++) bb.writeVarUint(i);
+    kiwi::ByteBufferStatistics statistics = bb.statistics();
+    assert(statistics.size == bb.size() && statistics.capacity >= bb.size());
+    assert(statistics.segments == 1 && statistics.reallocations > 0 && statistics.copiedBytes > 0);
+  }
+
+  assert(byteBufferStatistics.size() == 1 && byteBufferStatistics[0].reallocations > 0);
+
+  // Shallow skips keep their stack inline instead of creating a pool
+  {
+    kiwi::BinarySchema schema;
+    kiwi::ByteBuffer file;
+    uint32_t index = 0;
+    assert(readFile("test-schema.bkiwi", file) && schema.parse(file));
+    assert(schema.findDefinition("RecursiveMessage", index));
+    uint8_t data[] = {1, 1, 0, 0, 0};
+    kiwi::ByteBuffer bb(data, sizeof(data));
+    size_t count = memoryPoolStatistics.size();
+    assert(schema.skipField(bb, index, 1) && bb.index() == sizeof(data));
+    assert(memoryPoolStatistics.size() == count);
+  }
+
+  kiwi::statisticsHooks() = kiwi::StatisticsHooks();
+}
+#endif
+
+static void testVarUintPadding() {
+  puts("testVarUintPadding");
+
+  // Varints must decode the same way near the end of the buffer and away from it
+  auto check = [](std::vector<uint8_t> o, uint64_t i, size_t count) {
+    for (size_t padding = 0; padding < 10; padding++) {
+      std::vector<uint8_t> bytes = o;
+      bytes.resize(o.size() + padding, 0xFF);
+
+      if (count <= 5) {
+        kiwi::ByteBuffer bb(bytes.data(), bytes.size());
+        uint32_t value;
+        assert(bb.readVarUint(value));
+        assert(value == (uint32_t)i);
+        assert(bb.index() == count);
+      }
+
+      kiwi::ByteBuffer bb(bytes.data(), bytes.size());
+      uint64_t value;
+      assert(bb.readVarUint64(value));
+      assert(value == i);
+      assert(bb.index() == (count <= 5 ? o.size() : count));
+    }
+  };
+
+  check({0x00}, 0x00, 1);
+  check({0x7F}, 0x7F, 1);
+  check({0x80, 0x01}, 0x80, 2);
+  check({0xFF, 0xFF, 0x01}, 0x7FFF, 3);
+  check({0xFF, 0xFF, 0xFF, 0x7F}, 0xFFFFFFF, 4);
+  check({0x80, 0x80, 0x80, 0x80, 0x08}, 0x80000000, 5);
+  check({0xFF, 0xFF, 0xFF, 0xFF, 0x0F}, 0xFFFFFFFF, 5);
+  check({0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3F}, 0xFFFFFFFFFFFF, 7);
+  check({0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80}, 0x8000000000000000, 9);
+  check({0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}, 0xFFFFFFFFFFFFFFFF, 9);
+
+  // A 32-bit varint stops after 5 bytes even if the continuation bit is set
+  std::vector<uint8_t> o{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+  for (size_t size = 5; size <= o.size(); size++) {
+    kiwi::ByteBuffer bb(o.data(), size);
+    uint32_t value;
+    assert(bb.readVarUint(value));
+    assert(value == 0xFFFFFFFF);
+    assert(bb.index() == 5);
+  }
+
+  // Truncated varints fail
+  for (size_t size = 0; size < 9; size++) {
+    kiwi::ByteBuffer bb(o.data(), size);
+    uint64_t value;
+    assert(!bb.readVarUint64(value));
+  }
+}
+
+static void testVarUintArray() {
+  puts("testVarUintArray");
+
+  // Mix runs of single-byte values with longer ones to exercise the bulk
+  // decoder, followed by mostly multi-byte values (e.g. ids) of every length
+  // so they start and end at every offset within a 64-bit load
+  std::vector<uint32_t> uints;
+  std::vector<int32_t> ints;
+  for (uint32_t i = 0; i < 3000; i++) {
+    uint32_t value =
+      i < 1000 ? (i % 37 < 20 ? i % 100 : i * 2654435761u >> (i % 32)) :
+      i < 2000 ? 1000 + i * 2654435761u % 1000000 :
+      i * 2654435761u >> (i % 7 * 5);
+    uints.push_back(value);
+    ints.push_back(i & 1 ? -(int32_t)(value >> 1) : (int32_t)(value >> 1));
+  }
+
+  kiwi::ByteBuffer bb;
+  kiwi::MemoryPool pool;
+
+  test::UintArrayStruct s;
+  s.set_x(pool, uints.size()).set(uints.data(), uints.size());
+  assert(s.encode(bb));
+
+  test::IntArrayStruct s2;
+  s2.set_x(pool, ints.size()).set(ints.data(), ints.size());
+  assert(s2.encode(bb));
+
+  kiwi::ByteBuffer bb2(bb.data(), bb.size());
+  test::UintArrayStruct s3;
+  test::IntArrayStruct s4;
+  assert(s3.decode(bb2, pool));
+  assert(s4.decode(bb2, pool));
+  assert(bb2.index() == bb.size());
+  assert(std::vector<uint32_t>(s3.x()->begin(), s3.x()->end()) == uints);
+  assert(std::vector<int32_t>(s4.x()->begin(), s4.x()->end()) == ints);
+
+  // Running out of data partway through the array must fail
+  kiwi::ByteBuffer bb3(bb.data(), bb.size() - 1);
+  test::UintArrayStruct s5;
+  test::IntArrayStruct s6;
+  assert(s5.decode(bb3, pool));
+  assert(!s6.decode(bb3, pool));
+}
+
 int main() {
   testStructBool();
   testStructByte();
@@ -945,10 +2108,33 @@ int main() {
   testRecursiveMessage();
   testBinarySchema();
 
+  testSkipDepth();
+  testDynamicDecode();
+  testSchemaCache();
+  testSkipStructs();
   testLargeStruct();
   testLargeMessage();
   testDeprecatedFields();
 
+  testBorrowedStrings();
+  testEncodedSize();
+  testUncheckedWrites();
+  testSegmentedBuffer();
+  testStreamingInput();
+  testMappedFile();
+  testMemoryPool();
+  testAllocator();
+  testStreamingWindow();
+  testInlineMemoryPool();
+  testFailedArrayDecode();
+  testMemoryPoolRollback();
+  testThreadCache();
+#ifdef KIWI_STATISTICS
+  testStatistics();
+#endif
+  testVarUintPadding();
+  testVarUintArray();
+
   puts("all tests passed");
   return 0;
 }
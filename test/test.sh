@@ -18,6 +18,9 @@ node ../js/cli.js --schema ./test-schema-large.kiwi --cpp ./test-schema-large.h
 c++ ./test.cpp -std=c++11 -I..
 ./a.out
 rm ./a.out
+c++ ./test.cpp -std=c++11 -I.. -DKIWI_STATISTICS
+./a.out
+rm ./a.out
 
 node ../js/cli.js --schema ./test-schema.kiwi --callback-cpp ./test-schema-callback.h
 c++ ./test-callback.cpp -std=c++11 -I..
@@ -9,10 +9,17 @@ class BinarySchema {
 public:
   bool parse(kiwi::ByteBuffer &bb);
   const kiwi::BinarySchema &underlyingSchema() const { return _schema; }
+
+  // Whether all or one of the definitions compiled in here are exactly the same in the parsed schema
+  bool isIdentical() const { return _isIdentical; }
+  bool isIdentical(const char *definition) const;
+
   bool skipMessageField(kiwi::ByteBuffer &bb, uint32_t id) const;
 
 private:
   kiwi::BinarySchema _schema;
+  bool _isIdentical = false;
+  bool _identical[2] = {};
   uint32_t _indexMessage = 0;
 };
 
@@ -32,7 +39,9 @@ public:
   void set_b(const float &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -53,7 +62,9 @@ public:
   void set_y(Struct *value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -64,12 +75,31 @@ private:
 #endif
 #ifdef IMPLEMENT_SCHEMA_H
 
+static const struct { const char *name; uint32_t hash; } _definitionHashes[] = {
+  {"Struct", 3851118079u},
+  {"Message", 2760991712u},
+};
+
 bool BinarySchema::parse(kiwi::ByteBuffer &bb) {
   if (!_schema.parse(bb)) return false;
   _schema.findDefinition("Message", _indexMessage);
+  _isIdentical = true;
+  for (uint32_t i = 0; i < 2; i++) {
+    uint32_t index, hash;
+    _identical[i] = _schema.findDefinition(_definitionHashes[i].name, index) &&
+      _schema.definitionHash(index, hash) && hash == _definitionHashes[i].hash;
+    _isIdentical = _isIdentical && _identical[i];
+  }
   return true;
 }
 
+bool BinarySchema::isIdentical(const char *definition) const {
+  for (uint32_t i = 0; i < 2; i++) {
+    if (!strcmp(_definitionHashes[i].name, definition)) return _identical[i];
+  }
+  return false;
+}
+
 bool BinarySchema::skipMessageField(kiwi::ByteBuffer &bb, uint32_t id) const {
   return _schema.skipField(bb, _indexMessage, id);
 }
@@ -100,13 +130,31 @@ void Struct::set_b(const float &value) {
 
 bool Struct::encode(kiwi::ByteBuffer &_bb) {
   if (a() == nullptr) return false;
-  _bb.writeVarFloat(_data_a);
   if (b() == nullptr) return false;
+  if (_bb.writeBatchSize(1, 8)) {
+    uint8_t *_out = _bb.beginWrite(8);
+    kiwi::ByteBuffer::putVarFloat(_out, _data_a);
+    kiwi::ByteBuffer::putVarFloat(_out, _data_b);
+    _bb.endWrite(_out);
+    return true;
+  }
+  _bb.writeVarFloat(_data_a);
   _bb.writeVarFloat(_data_b);
   return true;
 }
 
-bool Struct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t Struct::encodedSize() const {
+  size_t _size = 0;
+  if (a() != nullptr) {
+    _size += kiwi::ByteBuffer::varFloatSize(_data_a);
+  }
+  if (b() != nullptr) {
+    _size += kiwi::ByteBuffer::varFloatSize(_data_b);
+  }
+  return _size;
+}
+
+bool Struct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   if (!_bb.readVarFloat(_data_a)) return false;
   set_a(_data_a);
   if (!_bb.readVarFloat(_data_b)) return false;
@@ -151,7 +199,18 @@ bool Message::encode(kiwi::ByteBuffer &_bb) {
   return true;
 }
 
-bool Message::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t Message::encodedSize() const {
+  size_t _size = 1;
+  if (x() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_x);
+  }
+  if (y() != nullptr) {
+    _size += 1 + _data_y->encodedSize();
+  }
+  return _size;
+}
+
+bool Message::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   while (true) {
     uint32_t _type;
     if (!_bb.readVarUint(_type)) return false;
@@ -165,7 +224,7 @@ bool Message::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const Binar
       }
       case 2: {
         _data_y = _pool.allocate<Struct>();
-        if (!_data_y->decode(_bb, _pool, _schema)) return false;
+        if (!_data_y->decode(_bb, _pool, _schema, _borrow)) return false;
         break;
       }
       default: {
@@ -9,11 +9,18 @@ class BinarySchema {
 public:
   bool parse(kiwi::ByteBuffer &bb);
   const kiwi::BinarySchema &underlyingSchema() const { return _schema; }
+
+  // Whether all or one of the definitions compiled in here are exactly the same in the parsed schema
+  bool isIdentical() const { return _isIdentical; }
+  bool isIdentical(const char *definition) const;
+
   bool skipMessageField(kiwi::ByteBuffer &bb, uint32_t id) const;
   bool skipMessage2Field(kiwi::ByteBuffer &bb, uint32_t id) const;
 
 private:
   kiwi::BinarySchema _schema;
+  bool _isIdentical = false;
+  bool _identical[4] = {};
   uint32_t _indexMessage = 0;
   uint32_t _indexMessage2 = 0;
 };
@@ -36,7 +43,9 @@ public:
   void set_b(const float &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -69,7 +78,9 @@ public:
   void set_d(Message2 *value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -93,7 +104,9 @@ public:
   void set_v(const bool &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -114,7 +127,9 @@ public:
   void set_f(const kiwi::String &value);
 
   bool encode(kiwi::ByteBuffer &bb);
-  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr);
+  size_t encodedSize() const;
+  bool decode(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr, bool borrow = false);
+  bool decodeBorrowed(kiwi::ByteBuffer &bb, kiwi::MemoryPool &pool, const BinarySchema *schema = nullptr) { return decode(bb, pool, schema, true); }
 
 private:
   uint32_t _flags[1] = {};
@@ -125,13 +140,34 @@ private:
 #endif
 #ifdef IMPLEMENT_SCHEMA_H
 
+static const struct { const char *name; uint32_t hash; } _definitionHashes[] = {
+  {"Struct", 3851118079u},
+  {"Message", 2729428311u},
+  {"Struct2", 2030425647u},
+  {"Message2", 1776841178u},
+};
+
 bool BinarySchema::parse(kiwi::ByteBuffer &bb) {
   if (!_schema.parse(bb)) return false;
   _schema.findDefinition("Message", _indexMessage);
   _schema.findDefinition("Message2", _indexMessage2);
+  _isIdentical = true;
+  for (uint32_t i = 0; i < 4; i++) {
+    uint32_t index, hash;
+    _identical[i] = _schema.findDefinition(_definitionHashes[i].name, index) &&
+      _schema.definitionHash(index, hash) && hash == _definitionHashes[i].hash;
+    _isIdentical = _isIdentical && _identical[i];
+  }
   return true;
 }
 
+bool BinarySchema::isIdentical(const char *definition) const {
+  for (uint32_t i = 0; i < 4; i++) {
+    if (!strcmp(_definitionHashes[i].name, definition)) return _identical[i];
+  }
+  return false;
+}
+
 bool BinarySchema::skipMessageField(kiwi::ByteBuffer &bb, uint32_t id) const {
   return _schema.skipField(bb, _indexMessage, id);
 }
@@ -166,13 +202,31 @@ void Struct::set_b(const float &value) {
 
 bool Struct::encode(kiwi::ByteBuffer &_bb) {
   if (a() == nullptr) return false;
-  _bb.writeVarFloat(_data_a);
   if (b() == nullptr) return false;
+  if (_bb.writeBatchSize(1, 8)) {
+    uint8_t *_out = _bb.beginWrite(8);
+    kiwi::ByteBuffer::putVarFloat(_out, _data_a);
+    kiwi::ByteBuffer::putVarFloat(_out, _data_b);
+    _bb.endWrite(_out);
+    return true;
+  }
+  _bb.writeVarFloat(_data_a);
   _bb.writeVarFloat(_data_b);
   return true;
 }
 
-bool Struct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t Struct::encodedSize() const {
+  size_t _size = 0;
+  if (a() != nullptr) {
+    _size += kiwi::ByteBuffer::varFloatSize(_data_a);
+  }
+  if (b() != nullptr) {
+    _size += kiwi::ByteBuffer::varFloatSize(_data_b);
+  }
+  return _size;
+}
+
+bool Struct::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   if (!_bb.readVarFloat(_data_a)) return false;
   set_a(_data_a);
   if (!_bb.readVarFloat(_data_b)) return false;
@@ -265,7 +319,27 @@ bool Message::encode(kiwi::ByteBuffer &_bb) {
   return true;
 }
 
-bool Message::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t Message::encodedSize() const {
+  size_t _size = 1;
+  if (x() != nullptr) {
+    _size += 1 + kiwi::ByteBuffer::varIntSize(_data_x);
+  }
+  if (y() != nullptr) {
+    _size += 1 + _data_y->encodedSize();
+  }
+  if (z() != nullptr) {
+    _size += 1 + _data_z->encodedSize();
+  }
+  if (c() != nullptr) {
+    _size += 1 + _data_c->encodedSize();
+  }
+  if (d() != nullptr) {
+    _size += 1 + _data_d->encodedSize();
+  }
+  return _size;
+}
+
+bool Message::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   while (true) {
     uint32_t _type;
     if (!_bb.readVarUint(_type)) return false;
@@ -279,22 +353,22 @@ bool Message::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const Binar
       }
       case 2: {
         _data_y = _pool.allocate<Struct>();
-        if (!_data_y->decode(_bb, _pool, _schema)) return false;
+        if (!_data_y->decode(_bb, _pool, _schema, _borrow)) return false;
         break;
       }
       case 3: {
         _data_z = _pool.allocate<Struct2>();
-        if (!_data_z->decode(_bb, _pool, _schema)) return false;
+        if (!_data_z->decode(_bb, _pool, _schema, _borrow)) return false;
         break;
       }
       case 4: {
         _data_c = _pool.allocate<Message>();
-        if (!_data_c->decode(_bb, _pool, _schema)) return false;
+        if (!_data_c->decode(_bb, _pool, _schema, _borrow)) return false;
         break;
       }
       case 5: {
         _data_d = _pool.allocate<Message2>();
-        if (!_data_d->decode(_bb, _pool, _schema)) return false;
+        if (!_data_d->decode(_bb, _pool, _schema, _borrow)) return false;
         break;
       }
       default: {
@@ -331,13 +405,31 @@ void Struct2::set_v(const bool &value) {
 
 bool Struct2::encode(kiwi::ByteBuffer &_bb) {
   if (u() == nullptr) return false;
-  _bb.writeByte(_data_u);
   if (v() == nullptr) return false;
+  if (_bb.writeBatchSize(1, 2)) {
+    uint8_t *_out = _bb.beginWrite(2);
+    kiwi::ByteBuffer::putByte(_out, _data_u);
+    kiwi::ByteBuffer::putByte(_out, _data_v);
+    _bb.endWrite(_out);
+    return true;
+  }
+  _bb.writeByte(_data_u);
   _bb.writeByte(_data_v);
   return true;
 }
 
-bool Struct2::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t Struct2::encodedSize() const {
+  size_t _size = 0;
+  if (u() != nullptr) {
+    _size += 1;
+  }
+  if (v() != nullptr) {
+    _size += 1;
+  }
+  return _size;
+}
+
+bool Struct2::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   if (!_bb.readByte(_data_u)) return false;
   set_u(_data_u);
   if (!_bb.readByte(_data_v)) return false;
@@ -372,17 +464,28 @@ void Message2::set_f(const kiwi::String &value) {
 bool Message2::encode(kiwi::ByteBuffer &_bb) {
   if (e() != nullptr) {
     _bb.writeVarUint(1);
-    _bb.writeString(_data_e.c_str());
+    _bb.writeString(_data_e);
   }
   if (f() != nullptr) {
     _bb.writeVarUint(2);
-    _bb.writeString(_data_f.c_str());
+    _bb.writeString(_data_f);
   }
   _bb.writeVarUint(0);
   return true;
 }
 
-bool Message2::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema) {
+size_t Message2::encodedSize() const {
+  size_t _size = 1;
+  if (e() != nullptr) {
+    _size += 1 + (_data_e.size() + 1);
+  }
+  if (f() != nullptr) {
+    _size += 1 + (_data_f.size() + 1);
+  }
+  return _size;
+}
+
+bool Message2::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const BinarySchema *_schema, bool _borrow) {
   while (true) {
     uint32_t _type;
     if (!_bb.readVarUint(_type)) return false;
@@ -390,12 +493,12 @@ bool Message2::decode(kiwi::ByteBuffer &_bb, kiwi::MemoryPool &_pool, const Bina
       case 0:
         return true;
       case 1: {
-        if (!_bb.readString(_data_e, _pool)) return false;
+        if (!(_borrow ? _bb.readBorrowedString(_data_e) : _bb.readString(_data_e, _pool))) return false;
         set_e(_data_e);
         break;
       }
       case 2: {
-        if (!_bb.readString(_data_f, _pool)) return false;
+        if (!(_borrow ? _bb.readBorrowedString(_data_f) : _bb.readString(_data_f, _pool))) return false;
         set_f(_data_f);
         break;
       }